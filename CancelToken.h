@@ -0,0 +1,36 @@
+#ifndef CANCELTOKEN_H
+#define CANCELTOKEN_H
+
+#include <QtGlobal>
+#include <atomic>
+
+// Cooperative cancellation for work that a newer request supersedes.
+//
+// A run keeps the generation it was started for; once the shared counter
+// has moved on, cancelled() turns true and the run should return early.
+// Loops only check every CheckInterval items, so a check costs nothing
+// measurable. A default-constructed token is never cancelled.
+class CancelToken
+{
+public:
+    // Items to process between two checks
+    static const int CheckInterval = 4096;
+
+    CancelToken() = default;
+    CancelToken(const std::atomic<quint64> *latest, quint64 generation)
+        : m_latest(latest)
+        , m_generation(generation)
+    {
+    }
+
+    bool cancelled() const
+    {
+        return m_latest && m_latest->load(std::memory_order_relaxed) != m_generation;
+    }
+
+private:
+    const std::atomic<quint64> *m_latest = nullptr;
+    quint64 m_generation = 0;
+};
+
+#endif // CANCELTOKEN_H
@@ -0,0 +1,358 @@
+#include "ChordIndex.h"
+#include <QDebug>
+
+namespace {
+
+struct ModifierName {
+    const char *name;
+    int bit;
+};
+
+// Accepted spellings, longest first where one contains another
+const ModifierName ModifierAliases[] = {
+    { "CONTROL", KeyChord::Ctrl },
+    { "SUPER", KeyChord::Super },
+    { "SHIFT", KeyChord::Shift },
+    { "CTRL", KeyChord::Ctrl },
+    { "CAPS", KeyChord::Caps },
+    { "LOGO", KeyChord::Super },
+    { "META", KeyChord::Super },
+    { "MOD2", KeyChord::Mod2 },
+    { "MOD3", KeyChord::Mod3 },
+    { "MOD4", KeyChord::Super },
+    { "MOD5", KeyChord::Mod5 },
+    { "ALT", KeyChord::Alt },
+    { "WIN", KeyChord::Super }
+};
+
+// Canonical names, in the order configs usually list them
+const ModifierName ModifierOrder[] = {
+    { "SUPER", KeyChord::Super },
+    { "SHIFT", KeyChord::Shift },
+    { "CTRL", KeyChord::Ctrl },
+    { "ALT", KeyChord::Alt },
+    { "CAPS", KeyChord::Caps },
+    { "MOD2", KeyChord::Mod2 },
+    { "MOD3", KeyChord::Mod3 },
+    { "MOD5", KeyChord::Mod5 }
+};
+
+// XKB keysym names (lower-cased) that have a Qt::Key of their own
+const QHash<QString, int> &namedKeys()
+{
+    static const QHash<QString, int> keys = {
+        { "return", Qt::Key_Return }, { "enter", Qt::Key_Return }, { "kp_enter", Qt::Key_Enter },
+        { "space", Qt::Key_Space }, { "tab", Qt::Key_Tab }, { "escape", Qt::Key_Escape },
+        { "backspace", Qt::Key_Backspace }, { "delete", Qt::Key_Delete }, { "insert", Qt::Key_Insert },
+        { "home", Qt::Key_Home }, { "end", Qt::Key_End },
+        { "prior", Qt::Key_PageUp }, { "page_up", Qt::Key_PageUp },
+        { "next", Qt::Key_PageDown }, { "page_down", Qt::Key_PageDown },
+        { "left", Qt::Key_Left }, { "right", Qt::Key_Right }, { "up", Qt::Key_Up }, { "down", Qt::Key_Down },
+        { "print", Qt::Key_Print }, { "pause", Qt::Key_Pause }, { "scroll_lock", Qt::Key_ScrollLock },
+        { "menu", Qt::Key_Menu },
+        { "minus", Qt::Key_Minus }, { "equal", Qt::Key_Equal }, { "plus", Qt::Key_Plus },
+        { "comma", Qt::Key_Comma }, { "period", Qt::Key_Period }, { "slash", Qt::Key_Slash },
+        { "backslash", Qt::Key_Backslash }, { "semicolon", Qt::Key_Semicolon },
+        { "apostrophe", Qt::Key_Apostrophe }, { "grave", Qt::Key_QuoteLeft },
+        { "bracketleft", Qt::Key_BracketLeft }, { "bracketright", Qt::Key_BracketRight },
+        { "exclam", Qt::Key_Exclam }, { "at", Qt::Key_At }, { "numbersign", Qt::Key_NumberSign },
+        { "dollar", Qt::Key_Dollar }, { "percent", Qt::Key_Percent }, { "asciicircum", Qt::Key_AsciiCircum },
+        { "ampersand", Qt::Key_Ampersand }, { "asterisk", Qt::Key_Asterisk },
+        { "parenleft", Qt::Key_ParenLeft }, { "parenright", Qt::Key_ParenRight },
+        { "underscore", Qt::Key_Underscore }, { "braceleft", Qt::Key_BraceLeft }, { "braceright", Qt::Key_BraceRight },
+        { "colon", Qt::Key_Colon }, { "quotedbl", Qt::Key_QuoteDbl }, { "less", Qt::Key_Less },
+        { "greater", Qt::Key_Greater }, { "question", Qt::Key_Question }, { "bar", Qt::Key_Bar },
+        { "asciitilde", Qt::Key_AsciiTilde },
+        { "xf86audioraisevolume", Qt::Key_VolumeUp }, { "xf86audiolowervolume", Qt::Key_VolumeDown },
+        { "xf86audiomute", Qt::Key_VolumeMute }, { "xf86audiomicmute", Qt::Key_MicMute },
+        { "xf86audioplay", Qt::Key_MediaPlay }, { "xf86audiopause", Qt::Key_MediaPause },
+        { "xf86audiostop", Qt::Key_MediaStop }, { "xf86audionext", Qt::Key_MediaNext },
+        { "xf86audioprev", Qt::Key_MediaPrevious },
+        { "xf86monbrightnessup", Qt::Key_MonBrightnessUp }, { "xf86monbrightnessdown", Qt::Key_MonBrightnessDown },
+        { "xf86calculator", Qt::Key_Calculator }, { "xf86poweroff", Qt::Key_PowerOff }
+    };
+    return keys;
+}
+
+struct KeyPair {
+    quint32 from;
+    int key;
+};
+
+// XKB keycodes (evdev code + 8) of the number row and punctuation keys,
+// with the Qt::Key they produce without Shift on a US layout
+const KeyPair PhysicalKeys[] = {
+    { 10, Qt::Key_1 }, { 11, Qt::Key_2 }, { 12, Qt::Key_3 }, { 13, Qt::Key_4 }, { 14, Qt::Key_5 },
+    { 15, Qt::Key_6 }, { 16, Qt::Key_7 }, { 17, Qt::Key_8 }, { 18, Qt::Key_9 }, { 19, Qt::Key_0 },
+    { 20, Qt::Key_Minus }, { 21, Qt::Key_Equal }, { 34, Qt::Key_BracketLeft }, { 35, Qt::Key_BracketRight },
+    { 47, Qt::Key_Semicolon }, { 48, Qt::Key_Apostrophe }, { 49, Qt::Key_QuoteLeft }, { 51, Qt::Key_Backslash },
+    { 59, Qt::Key_Comma }, { 60, Qt::Key_Period }, { 61, Qt::Key_Slash }
+};
+
+// Shifted symbols of a US layout and the key they are typed on, for events
+// without a scan code
+const KeyPair UsShiftedKeys[] = {
+    { Qt::Key_Exclam, Qt::Key_1 }, { Qt::Key_At, Qt::Key_2 }, { Qt::Key_NumberSign, Qt::Key_3 },
+    { Qt::Key_Dollar, Qt::Key_4 }, { Qt::Key_Percent, Qt::Key_5 }, { Qt::Key_AsciiCircum, Qt::Key_6 },
+    { Qt::Key_Ampersand, Qt::Key_7 }, { Qt::Key_Asterisk, Qt::Key_8 }, { Qt::Key_ParenLeft, Qt::Key_9 },
+    { Qt::Key_ParenRight, Qt::Key_0 }, { Qt::Key_Underscore, Qt::Key_Minus }, { Qt::Key_Plus, Qt::Key_Equal },
+    { Qt::Key_BraceLeft, Qt::Key_BracketLeft }, { Qt::Key_BraceRight, Qt::Key_BracketRight },
+    { Qt::Key_Colon, Qt::Key_Semicolon }, { Qt::Key_QuoteDbl, Qt::Key_Apostrophe },
+    { Qt::Key_AsciiTilde, Qt::Key_QuoteLeft }, { Qt::Key_Bar, Qt::Key_Backslash },
+    { Qt::Key_Less, Qt::Key_Comma }, { Qt::Key_Greater, Qt::Key_Period }, { Qt::Key_Question, Qt::Key_Slash }
+};
+
+// Modifier mask of a config modifier string, or -1 if part of it is unknown
+int parseModifiers(const QString &text)
+{
+    QString rest = text.toUpper();
+    int mask = 0;
+    for (const ModifierName &alias : ModifierAliases) {
+        const QLatin1String name(alias.name);
+        if (rest.contains(name)) {
+            mask |= alias.bit;
+            rest.remove(name);
+        }
+    }
+
+    // Only separators may be left
+    for (QChar ch : rest) {
+        if (ch != ' ' && ch != '_' && ch != '+' && ch != '\t') {
+            return -1;
+        }
+    }
+    return mask;
+}
+
+quint32 parseKey(const QString &text)
+{
+    const QString key = text.trimmed();
+    if (key.isEmpty()) {
+        return 0;
+    }
+
+    // "code:N" names the XKB keycode directly
+    if (key.startsWith("code:", Qt::CaseInsensitive)) {
+        bool ok = false;
+        const uint keycode = key.mid(5).toUInt(&ok);
+        return ok && keycode > 0 ? KeyChord::KeycodeFlag | keycode : 0;
+    }
+
+    if (key.size() == 1) {
+        const QChar ch = key.at(0).toUpper();
+        if (ch.unicode() > 0x20 && ch.unicode() < 0x7f) {
+            // Qt::Key_Exclam..Key_AsciiTilde, letters, digits and
+            // punctuation such as "=" or "/", are the ASCII codes
+            return ch.unicode();
+        }
+    }
+
+    if ((key.startsWith('F') || key.startsWith('f')) && key.size() <= 3) {
+        bool ok = false;
+        const int number = key.mid(1).toInt(&ok);
+        if (ok && number >= 1 && number <= 35) {
+            return quint32(Qt::Key_F1 + number - 1);
+        }
+    }
+
+    return quint32(namedKeys().value(key.toLower(), 0));
+}
+
+} // namespace
+
+KeyChord KeyChord::parse(const QString &modifiers, const QString &key)
+{
+    KeyChord chord;
+    const int mask = parseModifiers(modifiers);
+    if (mask < 0) {
+        return chord;
+    }
+    chord.key = parseKey(key);
+    chord.modifiers = chord.key ? quint8(mask) : 0;
+    return chord;
+}
+
+KeyChord KeyChord::fromKeybind(const QString &keybind)
+{
+    QString text = keybind;
+
+    // Binds of a submap are shown as "submap: chord"
+    const int submapEnd = text.indexOf(QLatin1String(": "));
+    if (submapEnd >= 0) {
+        text = text.mid(submapEnd + 2);
+    }
+
+    const int separator = text.lastIndexOf(QLatin1String(" + "));
+    if (separator < 0) {
+        return parse(QString(), text);
+    }
+    return parse(text.left(separator), text.mid(separator + 3));
+}
+
+KeyChord KeyChord::fromKeyEvent(int qtKey, int qtModifiers)
+{
+    KeyChord chord;
+    if (qtKey >= 'a' && qtKey <= 'z') {
+        qtKey -= 'a' - 'A';
+    }
+    chord.key = quint32(qtKey);
+    if (qtModifiers & Qt::ShiftModifier)
+        chord.modifiers |= Shift;
+    if (qtModifiers & Qt::ControlModifier)
+        chord.modifiers |= Ctrl;
+    if (qtModifiers & Qt::AltModifier)
+        chord.modifiers |= Alt;
+    if (qtModifiers & Qt::MetaModifier)
+        chord.modifiers |= Super;
+    return chord;
+}
+
+int KeyChord::unshiftedKey(int qtKey, quint32 nativeScanCode)
+{
+    // Letters and digits are reported unshifted already
+    if ((qtKey >= Qt::Key_0 && qtKey <= Qt::Key_9) || (qtKey >= Qt::Key_A && qtKey <= Qt::Key_Z)) {
+        return qtKey;
+    }
+    for (const KeyPair &physical : PhysicalKeys) {
+        if (physical.from == nativeScanCode) {
+            return physical.key;
+        }
+    }
+    for (const KeyPair &shifted : UsShiftedKeys) {
+        if (shifted.from == quint32(qtKey)) {
+            return shifted.key;
+        }
+    }
+    return qtKey;
+}
+
+KeyChord KeyChord::fromScanCode(quint32 nativeScanCode, int qtModifiers)
+{
+    KeyChord chord = fromKeyEvent(0, qtModifiers);
+    chord.key = nativeScanCode ? KeycodeFlag | nativeScanCode : 0;
+    return chord;
+}
+
+QString KeyChord::modifierNames(int modmask)
+{
+    QStringList names;
+    for (const ModifierName &modifier : ModifierOrder) {
+        if (modmask & modifier.bit) {
+            names.append(QLatin1String(modifier.name));
+        }
+    }
+    return names.join(' ');
+}
+
+QString KeyChord::displayText(const QString &modifiers, const QString &key)
+{
+    const KeyChord chord = parse(modifiers, key);
+    QString mods = modifiers;
+    QString keyText = key;
+    if (chord.isValid()) {
+        mods = modifierNames(chord.modifiers);
+        if (keyText.size() == 1) {
+            keyText = keyText.toUpper();
+        }
+    }
+
+    QString text = mods;
+    if (!text.isEmpty() && !keyText.isEmpty()) {
+        text += " + ";
+    }
+    return text + keyText;
+}
+
+void ChordIndex::build(const KeybindStore &store)
+{
+    clear();
+
+    // Parse each distinct keybind string once
+    QHash<quint32, KeyChord> parsed;
+
+    // (submap, chord) -> first item, to find binds that share a chord
+    QHash<QString, int> firstInSubmap;
+    QHash<QString, int> conflictOf;
+
+    for (int i = 0; i < store.size(); ++i) {
+        const quint32 id = store.stringId(i, KeybindStore::KeybindColumn);
+        auto it = parsed.constFind(id);
+        if (it == parsed.constEnd()) {
+            it = parsed.insert(id, KeyChord::fromKeybind(store.string(id)));
+        }
+        const KeyChord chord = it.value();
+        if (!chord.isValid()) {
+            continue;
+        }
+        m_items[chord.code()].push_back(quint32(i));
+
+        const QString &keybind = store.string(id);
+        const int submapEnd = keybind.indexOf(QLatin1String(": "));
+        const QString slot = (submapEnd >= 0 ? keybind.left(submapEnd) : QString())
+                           + QChar(0x1f) + QString::number(chord.code(), 16);
+
+        auto first = firstInSubmap.constFind(slot);
+        if (first == firstInSubmap.constEnd()) {
+            firstInSubmap.insert(slot, i);
+            continue;
+        }
+
+        auto conflict = conflictOf.constFind(slot);
+        if (conflict == conflictOf.constEnd()) {
+            Conflict entry;
+            entry.keybind = keybind;
+            entry.items.push_back(quint32(first.value()));
+            entry.duplicate = true;
+            conflict = conflictOf.insert(slot, int(m_conflicts.size()));
+            m_conflicts.append(entry);
+        }
+
+        Conflict &entry = m_conflicts[conflict.value()];
+        const int original = int(entry.items.front());
+        entry.duplicate = entry.duplicate
+            && store.stringId(i, KeybindStore::NameColumn) == store.stringId(original, KeybindStore::NameColumn)
+            && store.stringId(i, KeybindStore::DescriptionColumn) == store.stringId(original, KeybindStore::DescriptionColumn);
+        entry.items.push_back(quint32(i));
+    }
+
+    for (const Conflict &conflict : m_conflicts) {
+        QStringList names;
+        for (quint32 item : conflict.items) {
+            names.append(store.text(int(item), KeybindStore::NameColumn));
+        }
+        qWarning().noquote() << (conflict.duplicate ? "Duplicate keybind" : "Conflicting keybind")
+                             << conflict.keybind << "->" << names.join(", ");
+    }
+}
+
+void ChordIndex::clear()
+{
+    m_items.clear();
+    m_conflicts.clear();
+}
+
+const std::vector<quint32> &ChordIndex::find(const KeyChord &chord) const
+{
+    static const std::vector<quint32> none;
+    auto it = m_items.constFind(chord.code());
+    return it == m_items.constEnd() ? none : it.value();
+}
+
+const QList<ChordIndex::Conflict> &ChordIndex::conflicts() const
+{
+    return m_conflicts;
+}
+
+qint64 ChordIndex::memoryUsage() const
+{
+    qint64 bytes = qint64(m_items.capacity()) * qint64(sizeof(quint64) + sizeof(std::vector<quint32>) + sizeof(void *));
+    for (const std::vector<quint32> &items : m_items) {
+        bytes += qint64(items.capacity()) * qint64(sizeof(quint32));
+    }
+    for (const Conflict &conflict : m_conflicts) {
+        bytes += qint64(sizeof(Conflict))
+               + qint64(conflict.keybind.capacity()) * qint64(sizeof(QChar))
+               + qint64(conflict.items.capacity()) * qint64(sizeof(quint32));
+    }
+    return bytes;
+}
@@ -0,0 +1,94 @@
+#ifndef CHORDINDEX_H
+#define CHORDINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <vector>
+#include "KeybindStore.h"
+
+// A key combination normalized to (modifier mask, key).
+//
+// Modifiers use Hyprland's modmask bits, so "SUPER_SHIFT", "SHIFT SUPER"
+// and a j/binds modmask of 65 are the same chord. Keys are Qt::Key values,
+// which is what a QML key event reports; Hyprland's "code:N" keys are kept
+// as the XKB keycode N, matched against the event's native scan code.
+struct KeyChord {
+    enum Modifier {
+        Shift = 1,
+        Caps = 2,
+        Ctrl = 4,
+        Alt = 8,
+        Mod2 = 16,
+        Mod3 = 32,
+        Super = 64,
+        Mod5 = 128
+    };
+
+    // Marks a key that is an XKB keycode rather than a Qt::Key
+    static const quint32 KeycodeFlag = 0x80000000;
+
+    quint8 modifiers = 0;
+    quint32 key = 0;
+
+    bool isValid() const { return key != 0; }
+    quint64 code() const { return (quint64(modifiers) << 32) | key; }
+    bool operator==(const KeyChord &other) const { return code() == other.code(); }
+
+    // Chord of a config bind, e.g. ("SUPER_SHIFT", "w"); invalid if the
+    // modifiers or the key are not understood
+    static KeyChord parse(const QString &modifiers, const QString &key);
+
+    // Chord of a displayed keybind, "SUPER SHIFT + W" or "resize: ALT + L"
+    static KeyChord fromKeybind(const QString &keybind);
+
+    // Chord of a key press as reported to QML (event.key, event.modifiers)
+    static KeyChord fromKeyEvent(int qtKey, int qtModifiers);
+    static KeyChord fromScanCode(quint32 nativeScanCode, int qtModifiers);
+
+    // Key a Shift-modified press was typed on: with Shift, Qt reports the
+    // shifted symbol (Key_Exclam for Shift+1), while binds name the key.
+    // Found by the scan code's position on the keyboard, or else from the
+    // US layout's symbols; other keys are returned unchanged.
+    static int unshiftedKey(int qtKey, quint32 nativeScanCode);
+
+    // Modifier names in a fixed order, e.g. "SUPER SHIFT"
+    static QString modifierNames(int modmask);
+
+    // modifiers + " + " + key with the modifiers spelled the canonical way and
+    // single-character keys upper-cased; the raw text if it does not parse
+    static QString displayText(const QString &modifiers, const QString &key);
+};
+
+// Hash index from chords to keybinds, with the binds that share a chord
+//
+// Built in one pass over the store; each distinct keybind string is parsed
+// once. Chords are compared within a submap, since the same combination in
+// two submaps is not a conflict.
+class ChordIndex
+{
+public:
+    // Keybinds bound to the same chord in the same submap
+    struct Conflict {
+        QString keybind;
+        std::vector<quint32> items;
+        bool duplicate;     // Every item does the same thing
+    };
+
+    void build(const KeybindStore &store);
+    void clear();
+
+    // Items bound to chord in any submap, in store order
+    const std::vector<quint32> &find(const KeyChord &chord) const;
+
+    const QList<Conflict> &conflicts() const;
+
+    // Approximate heap usage in bytes
+    qint64 memoryUsage() const;
+
+private:
+    QHash<quint64, std::vector<quint32>> m_items;
+    QList<Conflict> m_conflicts;
+};
+
+#endif // CHORDINDEX_H
@@ -0,0 +1,100 @@
+#include "DaemonServer.h"
+#include <QDir>
+#include <QStandardPaths>
+#include <QDebug>
+
+// Timeout for client-side socket operations in milliseconds
+static const int ClientTimeout = 500;
+
+// Constructor
+DaemonServer::DaemonServer(QObject *parent)
+    : QObject(parent)
+    , m_server(new QLocalServer(this))
+{
+    // Only the current user may talk to the daemon
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &DaemonServer::handleNewConnection);
+}
+
+QString DaemonServer::socketPath()
+{
+    QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    if (runtimeDir.isEmpty()) {
+        runtimeDir = QDir::tempPath();
+    }
+    return QDir(runtimeDir).filePath("fredon-modal-cheat.sock");
+}
+
+bool DaemonServer::listen()
+{
+    QString path = socketPath();
+
+    if (m_server->listen(path)) {
+        qDebug() << "Daemon listening on" << path;
+        return true;
+    }
+
+    // The socket file may be left over from a daemon that crashed
+    if (m_server->serverError() == QAbstractSocket::AddressInUseError) {
+        QLocalSocket probe;
+        probe.connectToServer(path);
+        if (probe.waitForConnected(ClientTimeout)) {
+            qWarning() << "Another daemon is already running on" << path;
+            return false;
+        }
+
+        QLocalServer::removeServer(path);
+        if (m_server->listen(path)) {
+            qDebug() << "Daemon listening on" << path << "(removed stale socket)";
+            return true;
+        }
+    }
+
+    qWarning() << "Could not listen on" << path << ":" << m_server->errorString();
+    return false;
+}
+
+bool DaemonServer::sendCommand(const QByteArray &command)
+{
+    QLocalSocket socket;
+    socket.connectToServer(socketPath());
+    if (!socket.waitForConnected(ClientTimeout)) {
+        return false;
+    }
+
+    socket.write(command + '\n');
+    if (!socket.waitForBytesWritten(ClientTimeout)) {
+        return false;
+    }
+
+    socket.disconnectFromServer();
+    if (socket.state() != QLocalSocket::UnconnectedState) {
+        socket.waitForDisconnected(ClientTimeout);
+    }
+    return true;
+}
+
+void DaemonServer::handleNewConnection()
+{
+    while (QLocalSocket *client = m_server->nextPendingConnection()) {
+        connect(client, &QLocalSocket::readyRead, this, [this, client]() {
+            while (client->canReadLine()) {
+                handleCommand(client->readLine().trimmed());
+            }
+        });
+        connect(client, &QLocalSocket::disconnected, client, &QLocalSocket::deleteLater);
+    }
+}
+
+void DaemonServer::handleCommand(const QByteArray &command)
+{
+    if (command == "show") {
+        emit showRequested();
+    } else if (command == "hide") {
+        emit hideRequested();
+    } else if (command == "toggle") {
+        emit toggleRequested();
+    } else {
+        qWarning() << "Unknown daemon command:" << command;
+    }
+}
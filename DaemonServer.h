@@ -0,0 +1,42 @@
+#ifndef DAEMONSERVER_H
+#define DAEMONSERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+// Local socket server used by the resident (--daemon) instance.
+// Clients send one command per line: "show", "hide" or "toggle".
+class DaemonServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DaemonServer(QObject *parent = nullptr);
+
+    // Start listening; returns false if another daemon already owns the socket
+    bool listen();
+
+    // Client side: deliver a single command to a running daemon
+    static bool sendCommand(const QByteArray &command);
+
+    // Location of the control socket
+    static QString socketPath();
+
+signals:
+    void showRequested();
+    void hideRequested();
+    void toggleRequested();
+
+private slots:
+    void handleNewConnection();
+
+private:
+    void handleCommand(const QByteArray &command);
+
+    QLocalServer *m_server;
+};
+
+#endif // DAEMONSERVER_H
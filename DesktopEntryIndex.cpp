@@ -0,0 +1,381 @@
+#include "DesktopEntryIndex.h"
+#include <QDataStream>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QDebug>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const quint32 CacheMagic = 0x48444549; // "HDEI"
+
+// Files per pool task; small directories are parsed on one thread
+const int ChunkSize = 64;
+
+struct ParsedEntry {
+    QStringList keys;       // Exec/TryExec basenames and the desktop file id
+    DesktopEntry entry;
+};
+
+// Basename of the program an Exec line runs, skipping "env VAR=value"
+QString programName(const QString &exec)
+{
+    const QStringList tokens = exec.split(' ', Qt::SkipEmptyParts);
+    for (int i = 0; i < tokens.size(); ++i) {
+        QString token = tokens.at(i);
+        if (token.startsWith('"') && token.endsWith('"') && token.size() >= 2) {
+            token = token.mid(1, token.size() - 2);
+        }
+        if (token == "env" || token.contains('=')) {
+            continue;
+        }
+        return QFileInfo(token).fileName();
+    }
+    return QString();
+}
+
+// Read the [Desktop Entry] group; returns false for hidden or non-application entries
+bool parseDesktopFile(const QString &path, const QString &id, ParsedEntry *result)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    bool inGroup = false;
+    QString type;
+    QString exec;
+    QString tryExec;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        if (line.startsWith('[')) {
+            // Only the first group matters; actions follow it
+            if (inGroup) {
+                break;
+            }
+            inGroup = line == "[Desktop Entry]";
+            continue;
+        }
+        if (!inGroup) {
+            continue;
+        }
+
+        const int equalPos = line.indexOf('=');
+        if (equalPos <= 0) {
+            continue;
+        }
+        const QByteArray key = line.left(equalPos).trimmed();
+        const QString value = QString::fromUtf8(line.mid(equalPos + 1).trimmed());
+        if (key == "Name") {
+            result->entry.name = value;
+        } else if (key == "Icon") {
+            result->entry.icon = value;
+        } else if (key == "Comment") {
+            result->entry.comment = value;
+        } else if (key == "Exec") {
+            exec = value;
+        } else if (key == "TryExec") {
+            tryExec = value;
+        } else if (key == "Type") {
+            type = value;
+        } else if (key == "Hidden" && value == "true") {
+            return false;
+        }
+    }
+
+    if (type != "Application") {
+        return false;
+    }
+
+    const QString execName = programName(exec);
+    if (!execName.isEmpty()) {
+        result->keys.append(execName);
+    }
+    const QString tryExecName = programName(tryExec);
+    if (!tryExecName.isEmpty() && tryExecName != execName) {
+        result->keys.append(tryExecName);
+    }
+    result->keys.append(id);
+    return true;
+}
+
+} // namespace
+
+// Constructor
+DesktopEntryIndex::DesktopEntryIndex(const QString &cachePath)
+    : m_cachePath(cachePath)
+    , m_loaded(false)
+{
+}
+
+QString DesktopEntryIndex::defaultCachePath()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("desktop-entries.cache");
+}
+
+QString DesktopEntryIndex::overridesPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + "/fredon-modal-cheat/applications.conf";
+}
+
+QStringList DesktopEntryIndex::applicationDirs()
+{
+    // $XDG_DATA_HOME/applications, then $XDG_DATA_DIRS/applications in order
+    return QStandardPaths::standardLocations(QStandardPaths::ApplicationsLocation);
+}
+
+DesktopEntry DesktopEntryIndex::builtin(const QString &executable)
+{
+    static const QHash<QString, QString> names = {
+        { "kitty", "Terminal" },
+        { "hyprshot", "Screenshot" },
+        { "hyprpicker", "Color Picker" },
+        { "code", "Code Editor" },
+        { "walker", "Application Launcher" },
+        { "waypaper", "Wallpaper Changer" },
+        { "wlogout", "Power Menu" },
+        { "swaync-client", "Notifications" },
+        { "btop", "System Monitor" },
+        { "lazydocker", "Docker Manager" },
+        { "clipse", "Clipboard Manager" }
+    };
+
+    DesktopEntry entry;
+    entry.name = names.value(executable);
+    return entry;
+}
+
+void DesktopEntryIndex::load()
+{
+    clear();
+    loadOverrides();
+    if (!loadCache()) {
+        build();
+        storeCache();
+    }
+    m_loaded = true;
+}
+
+bool DesktopEntryIndex::isLoaded() const
+{
+    return m_loaded;
+}
+
+void DesktopEntryIndex::clear()
+{
+    m_entries.clear();
+    m_overrides.clear();
+    m_dirStamps.clear();
+    m_loaded = false;
+}
+
+DesktopEntry DesktopEntryIndex::resolve(const QString &executable) const
+{
+    DesktopEntry result = m_entries.value(executable);
+
+    // Built-in names only fill in for programs without a desktop entry name
+    if (result.name.isEmpty()) {
+        result.name = builtin(executable).name;
+    }
+
+    auto it = m_overrides.constFind(executable);
+    if (it != m_overrides.constEnd()) {
+        if (!it->name.isEmpty()) result.name = it->name;
+        if (!it->icon.isEmpty()) result.icon = it->icon;
+        if (!it->comment.isEmpty()) result.comment = it->comment;
+    }
+    return result;
+}
+
+QStringList DesktopEntryIndex::inputPaths() const
+{
+    QStringList paths;
+    paths.reserve(m_dirStamps.size() + 1);
+    for (const FileStamp &stamp : m_dirStamps) {
+        paths.append(stamp.path);
+    }
+    paths.append(overridesPath());
+    return paths;
+}
+
+int DesktopEntryIndex::size() const
+{
+    return int(m_entries.size());
+}
+
+void DesktopEntryIndex::loadOverrides()
+{
+    const QString path = overridesPath();
+    if (!QFile::exists(path)) {
+        return;
+    }
+
+    QSettings settings(path, QSettings::IniFormat);
+    const QStringList groups = settings.childGroups();
+    for (const QString &group : groups) {
+        settings.beginGroup(group);
+        DesktopEntry entry;
+        entry.name = settings.value("Name").toString();
+        entry.icon = settings.value("Icon").toString();
+        entry.comment = settings.value("Comment").toString();
+        settings.endGroup();
+        m_overrides.insert(group, entry);
+    }
+}
+
+// Scan every application directory and parse its .desktop files on a thread pool
+void DesktopEntryIndex::build()
+{
+    struct Source {
+        QString path;
+        QString id;
+    };
+    std::vector<Source> sources;
+
+    // Desktop file ids use '-' for subdirectories, e.g. kde4-foo.desktop
+    const QStringList roots = applicationDirs();
+    for (const QString &root : roots) {
+        m_dirStamps.append(FileStamp::fromPath(root));
+        QDirIterator dirs(root, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (dirs.hasNext()) {
+            m_dirStamps.append(FileStamp::fromPath(dirs.next()));
+        }
+
+        const QDir rootDir(root);
+        QDirIterator files(root, { "*.desktop" }, QDir::Files, QDirIterator::Subdirectories);
+        while (files.hasNext()) {
+            const QString path = files.next();
+            QString id = rootDir.relativeFilePath(path);
+            id.chop(8); // ".desktop"
+            id.replace('/', '-');
+            sources.push_back({ path, id });
+        }
+    }
+
+    // Parse in chunks; results keep the scan order so earlier directories win
+    std::vector<std::vector<ParsedEntry>> chunks((sources.size() + ChunkSize - 1) / ChunkSize);
+    auto parseChunk = [&sources, &chunks](size_t chunk) {
+        const size_t end = std::min(sources.size(), (chunk + 1) * ChunkSize);
+        for (size_t i = chunk * ChunkSize; i < end; ++i) {
+            ParsedEntry parsed;
+            if (parseDesktopFile(sources[i].path, sources[i].id, &parsed)) {
+                chunks[chunk].push_back(parsed);
+            }
+        }
+    };
+
+    if (chunks.size() == 1) {
+        parseChunk(0);
+    } else {
+        QThreadPool pool;
+        for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+            pool.start([&parseChunk, chunk]() {
+                parseChunk(chunk);
+            });
+        }
+        pool.waitForDone();
+    }
+
+    for (const std::vector<ParsedEntry> &chunk : chunks) {
+        for (const ParsedEntry &parsed : chunk) {
+            for (const QString &key : parsed.keys) {
+                if (!m_entries.contains(key)) {
+                    m_entries.insert(key, parsed.entry);
+                }
+            }
+        }
+    }
+
+    qDebug() << "Indexed" << sources.size() << "desktop files," << m_entries.size() << "lookup keys";
+}
+
+bool DesktopEntryIndex::loadCache()
+{
+    QFile file(m_cachePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != CacheMagic || version != FormatVersion) {
+        return false;
+    }
+
+    // The same directories must exist with unchanged stamps
+    QStringList roots;
+    in >> roots;
+    if (roots != applicationDirs()) {
+        return false;
+    }
+
+    quint32 stampCount = 0;
+    in >> stampCount;
+    QList<FileStamp> stamps;
+    stamps.reserve(stampCount);
+    for (quint32 i = 0; i < stampCount && in.status() == QDataStream::Ok; ++i) {
+        FileStamp stamp;
+        in >> stamp.path >> stamp.size >> stamp.mtimeNs >> stamp.inode;
+        if (FileStamp::fromPath(stamp.path) != stamp) {
+            qDebug() << "Desktop entry cache miss: changed" << stamp.path;
+            return false;
+        }
+        stamps.append(stamp);
+    }
+
+    quint32 entryCount = 0;
+    in >> entryCount;
+    QHash<QString, DesktopEntry> entries;
+    entries.reserve(entryCount);
+    for (quint32 i = 0; i < entryCount && in.status() == QDataStream::Ok; ++i) {
+        QString key;
+        DesktopEntry entry;
+        in >> key >> entry.name >> entry.icon >> entry.comment;
+        entries.insert(key, entry);
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    m_dirStamps = stamps;
+    m_entries = entries;
+    return true;
+}
+
+void DesktopEntryIndex::storeCache() const
+{
+    QDir().mkpath(QFileInfo(m_cachePath).absolutePath());
+
+    QSaveFile file(m_cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write desktop entry cache:" << m_cachePath;
+        return;
+    }
+
+    QDataStream out(&file);
+    out << CacheMagic << FormatVersion << applicationDirs();
+    out << quint32(m_dirStamps.size());
+    for (const FileStamp &stamp : m_dirStamps) {
+        out << stamp.path << stamp.size << stamp.mtimeNs << stamp.inode;
+    }
+    out << quint32(m_entries.size());
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        out << it.key() << it->name << it->icon << it->comment;
+    }
+
+    if (!file.commit()) {
+        qWarning() << "Could not write desktop entry cache:" << m_cachePath;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef DESKTOPENTRYINDEX_H
+#define DESKTOPENTRYINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include "FileStamp.h"
+
+// What an exec bind's program is shown as
+struct DesktopEntry {
+    QString name;
+    QString icon;
+    QString comment;
+};
+
+// Executable name -> desktop entry, built from the .desktop files in
+// $XDG_DATA_HOME/applications and $XDG_DATA_DIRS/applications.
+//
+// Files are parsed in parallel and the result is written to a cache keyed
+// by the stamps of every scanned directory, so as long as no application is
+// installed or removed, load() is a few stats and one read. Entries are found
+// by the basename of their Exec (and TryExec) program and by desktop file id.
+// resolve() puts the user's overrides file on top and falls back to the
+// built-in friendly names for programs whose entry has no name.
+class DesktopEntryIndex
+{
+public:
+    // Bump whenever the cache layout changes
+    static const quint32 FormatVersion = 1;
+
+    explicit DesktopEntryIndex(const QString &cachePath = defaultCachePath());
+
+    static QString defaultCachePath();
+
+    // User overrides: an INI file with one [executable] group per program
+    // and Name, Icon and Comment keys
+    static QString overridesPath();
+
+    // Directories searched for .desktop files, highest priority first
+    static QStringList applicationDirs();
+
+    // Built-in friendly names for common programs, e.g. kitty -> "Terminal";
+    // used only where no desktop entry provides a name
+    static DesktopEntry builtin(const QString &executable);
+
+    // Fill the index from the cache, or scan and re-cache if it is stale
+    void load();
+    bool isLoaded() const;
+    void clear();
+
+    // Overrides, then the desktop entry, then built-in names; empty fields
+    // fall through to the next layer
+    DesktopEntry resolve(const QString &executable) const;
+
+    // Paths whose change invalidates the index: scanned directories and the overrides file
+    QStringList inputPaths() const;
+
+    int size() const;
+
+private:
+    bool loadCache();
+    void build();
+    void storeCache() const;
+    void loadOverrides();
+
+    QString m_cachePath;
+    bool m_loaded;
+    QHash<QString, DesktopEntry> m_entries;
+    QHash<QString, DesktopEntry> m_overrides;
+    QList<FileStamp> m_dirStamps;
+};
+
+#endif // DESKTOPENTRYINDEX_H
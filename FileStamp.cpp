@@ -0,0 +1,35 @@
+#include "FileStamp.h"
+#include <QFile>
+#include <sys/stat.h>
+
+bool FileStamp::operator==(const FileStamp &other) const
+{
+    return path == other.path
+        && size == other.size
+        && mtimeNs == other.mtimeNs
+        && inode == other.inode;
+}
+
+FileStamp FileStamp::fromPath(const QString &path)
+{
+    FileStamp stamp;
+    stamp.path = path;
+
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) == 0) {
+        stamp.size = qint64(st.st_size);
+        stamp.mtimeNs = qint64(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+        stamp.inode = quint64(st.st_ino);
+    }
+    return stamp;
+}
+
+quint64 contentHash(QByteArrayView data)
+{
+    quint64 hash = 14695981039346656037ULL;
+    for (char c : data) {
+        hash ^= quint8(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
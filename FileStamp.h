@@ -0,0 +1,26 @@
+#ifndef FILESTAMP_H
+#define FILESTAMP_H
+
+#include <QByteArrayView>
+#include <QString>
+
+// Identity of a file at the time it was read
+struct FileStamp {
+    QString path;
+    qint64 size = -1;
+    qint64 mtimeNs = 0;
+    quint64 inode = 0;
+
+    bool exists() const { return size >= 0; }
+    bool operator==(const FileStamp &other) const;
+    bool operator!=(const FileStamp &other) const { return !(*this == other); }
+
+    // Stat the file; a missing file yields a stamp with size -1
+    static FileStamp fromPath(const QString &path);
+};
+
+// 64-bit FNV-1a of data. Not cryptographic, but stable across runs and
+// builds, so it can be persisted to tell whether file contents changed.
+quint64 contentHash(QByteArrayView data);
+
+#endif // FILESTAMP_H
@@ -0,0 +1,326 @@
+#include "FuzzyMatcher.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Scoring constants, following fzf's v1 algorithm
+const int ScoreMatch = 16;
+const int ScoreGapStart = -3;
+const int ScoreGapExtension = -1;
+const int BonusBoundary = ScoreMatch / 2;
+const int BonusCamel = BonusBoundary - 1;
+const int BonusConsecutive = -(ScoreGapStart + ScoreGapExtension);
+const int BonusKeyToken = BonusBoundary + 2;
+const int BonusFirstCharMultiplier = 2;
+
+// Name matches rank above keybind matches, which rank above descriptions
+const int FieldWeight[FuzzyMatcher::FieldCount] = { 8, 4, 0 };
+
+// Byte used for characters that no ASCII query can match
+const char NonAscii = char(0xff);
+
+enum CharClass {
+    ClassNonWord,
+    ClassDelimiter,
+    ClassLower,
+    ClassUpper,
+    ClassDigit
+};
+
+CharClass classOf(char16_t c)
+{
+    if (c >= 'a' && c <= 'z')
+        return ClassLower;
+    if (c >= 'A' && c <= 'Z')
+        return ClassUpper;
+    if (c >= '0' && c <= '9')
+        return ClassDigit;
+    switch (c) {
+    case ' ': case '+': case '_': case '-': case '/': case '.':
+    case ',': case ':': case '=': case '"': case '\'': case '(': case ')':
+        return ClassDelimiter;
+    default:
+        return ClassNonWord;
+    }
+}
+
+int bonusFor(CharClass previous, CharClass current, bool keyToken)
+{
+    if (current == ClassNonWord || current == ClassDelimiter)
+        return 0;
+    if (previous == ClassDelimiter || previous == ClassNonWord)
+        return keyToken ? BonusKeyToken : BonusBoundary;
+    if (previous == ClassLower && current == ClassUpper)
+        return BonusCamel;
+    if (previous != ClassDigit && current == ClassDigit)
+        return BonusCamel;
+    return 0;
+}
+
+char foldAscii(char16_t c)
+{
+    if (c >= 0x80)
+        return NonAscii;
+    if (c >= 'A' && c <= 'Z')
+        return char(c - 'A' + 'a');
+    return char(c);
+}
+
+// One bit per letter and digit, the rest share the remaining bits
+quint64 maskBit(char c)
+{
+    const unsigned char u = static_cast<unsigned char>(c);
+    if (u >= 'a' && u <= 'z')
+        return quint64(1) << (u - 'a');
+    if (u >= '0' && u <= '9')
+        return quint64(1) << (26 + u - '0');
+    return quint64(1) << (36 + u % 28);
+}
+
+// Score pattern against text, or return -1 if it is not a subsequence.
+// Matched positions are written to positions if it is non-null.
+int scoreKernel(const char *text, const quint8 *bonus, int length,
+                const char *pattern, int patternLength, int *positions)
+{
+    if (patternLength > length)
+        return -1;
+
+    // Forward scan: leftmost position where the whole pattern has matched
+    int from = 0;
+    int first = -1;
+    for (int j = 0; j < patternLength; ++j) {
+        const void *hit = std::memchr(text + from, pattern[j], size_t(length - from));
+        if (!hit)
+            return -1;
+        const int at = int(static_cast<const char *>(hit) - text);
+        if (j == 0)
+            first = at;
+        from = at + 1;
+    }
+    const int end = from;
+
+    // Backward scan: tightest window ending there
+    int start = first;
+    for (int i = end - 1, j = patternLength - 1; i >= first; --i) {
+        if (text[i] == pattern[j] && --j < 0) {
+            start = i;
+            break;
+        }
+    }
+
+    // Score the window
+    int score = 0;
+    int consecutive = 0;
+    int firstBonus = 0;
+    bool inGap = false;
+    for (int i = start, j = 0; i < end && j < patternLength; ++i) {
+        if (text[i] == pattern[j]) {
+            int b = bonus[i];
+            if (consecutive == 0) {
+                firstBonus = b;
+            } else {
+                if (b >= BonusBoundary && b > firstBonus)
+                    firstBonus = b;
+                b = std::max(std::max(b, firstBonus), BonusConsecutive);
+            }
+            score += ScoreMatch + (j == 0 ? b * BonusFirstCharMultiplier : b);
+            if (positions)
+                positions[j] = i;
+            inGap = false;
+            ++consecutive;
+            ++j;
+        } else {
+            score += inGap ? ScoreGapExtension : ScoreGapStart;
+            inGap = true;
+            consecutive = 0;
+            firstBonus = 0;
+        }
+    }
+    return score;
+}
+
+} // namespace
+
+void FuzzyMatcher::build(const KeybindStore &store)
+{
+    clear();
+
+    const KeybindStore::Column columns[FieldCount] = {
+        KeybindStore::NameColumn,
+        KeybindStore::KeybindColumn,
+        KeybindStore::DescriptionColumn
+    };
+
+    // Each distinct string is folded once; keybinds get their own copy
+    // because their token bonuses differ
+    std::vector<qint64> textRefs(size_t(store.stringCount()), -1);
+    std::vector<qint64> keybindRefs(size_t(store.stringCount()), -1);
+
+    m_fields.reserve(size_t(store.size()) * FieldCount);
+    for (int i = 0; i < store.size(); ++i) {
+        for (int field = 0; field < FieldCount; ++field) {
+            const quint32 id = store.stringId(i, columns[field]);
+            qint64 &ref = field == KeybindField ? keybindRefs[id] : textRefs[id];
+            if (ref < 0) {
+                ref = addString(store.string(id), field == KeybindField);
+            }
+            m_fields.push_back(quint32(ref));
+        }
+    }
+}
+
+quint32 FuzzyMatcher::addString(const QString &text, bool keyToken)
+{
+    FieldRef ref;
+    ref.offset = quint32(m_text.size());
+    ref.length = quint32(text.size());
+
+    quint64 mask = 0;
+    CharClass previous = ClassDelimiter;
+    for (QChar ch : text) {
+        const char16_t c = ch.unicode();
+        const CharClass current = classOf(c);
+        const char folded = foldAscii(c);
+        m_text.push_back(folded);
+        m_bonus.push_back(quint8(bonusFor(previous, current, keyToken)));
+        mask |= maskBit(folded);
+        previous = current;
+    }
+
+    m_refs.push_back(ref);
+    m_masks.push_back(mask);
+    return quint32(m_refs.size() - 1);
+}
+
+void FuzzyMatcher::clear()
+{
+    m_text.clear();
+    m_bonus.clear();
+    m_refs.clear();
+    m_masks.clear();
+    m_fields.clear();
+}
+
+qint64 FuzzyMatcher::memoryUsage() const
+{
+    return qint64(m_text.capacity())
+         + qint64(m_bonus.capacity())
+         + qint64(m_refs.capacity()) * qint64(sizeof(FieldRef))
+         + qint64(m_masks.capacity()) * qint64(sizeof(quint64))
+         + qint64(m_fields.capacity()) * qint64(sizeof(quint32));
+}
+
+bool FuzzyMatcher::prepare(const QString &text, Query *query)
+{
+    query->text = text;
+    query->length = 0;
+    query->mask = 0;
+
+    if (text.isEmpty() || text.size() > MaxQueryLength)
+        return false;
+
+    for (QChar ch : text) {
+        const char folded = foldAscii(ch.unicode());
+        if (folded == NonAscii) {
+            query->length = 0;
+            query->mask = 0;
+            return false;
+        }
+        query->pattern[query->length++] = folded;
+        query->mask |= maskBit(folded);
+    }
+    return true;
+}
+
+int FuzzyMatcher::scoreField(const Query &query, int item, Field field, int *positions) const
+{
+    const quint32 slot = m_fields[size_t(item) * FieldCount + field];
+    if ((query.mask & ~m_masks[slot]) != 0)
+        return -1;
+
+    const FieldRef &ref = m_refs[slot];
+    return scoreKernel(m_text.data() + ref.offset, m_bonus.data() + ref.offset, int(ref.length),
+                       query.pattern, query.length, positions);
+}
+
+int FuzzyMatcher::score(const Query &query, int item) const
+{
+    if (query.length == 0)
+        return -1;
+
+    int best = -1;
+    for (int field = 0; field < FieldCount; ++field) {
+        const int s = scoreField(query, item, Field(field), nullptr);
+        if (s >= 0)
+            best = std::max(best, s + FieldWeight[field]);
+    }
+    return best;
+}
+
+bool FuzzyMatcher::rank(const Query &query, const std::vector<quint32> *candidates, std::vector<quint32> *result,
+                        Scratch *scratch, const CancelToken &cancel) const
+{
+    result->clear();
+    scratch->clear();
+
+    const quint32 count = candidates ? quint32(candidates->size()) : quint32(m_fields.size() / FieldCount);
+    for (quint32 i = 0; i < count; ++i) {
+        if (i % CancelToken::CheckInterval == 0 && cancel.cancelled())
+            return false;
+        const quint32 item = candidates ? (*candidates)[i] : i;
+        const int s = score(query, int(item));
+        if (s >= 0)
+            scratch->emplace_back(s, item);
+    }
+
+    // Best score first, item order breaks ties
+    std::sort(scratch->begin(), scratch->end(), [](const std::pair<int, quint32> &a, const std::pair<int, quint32> &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    result->reserve(scratch->size());
+    for (const auto &entry : *scratch)
+        result->push_back(entry.second);
+    return true;
+}
+
+QList<int> FuzzyMatcher::matchRanges(const Query &query, int item, Field field) const
+{
+    QList<int> ranges;
+    if (query.length == 0 || size_t(item) * FieldCount >= m_fields.size())
+        return ranges;
+
+    int positions[MaxQueryLength];
+    if (scoreField(query, item, field, positions) < 0)
+        return ranges;
+
+    // Merge adjacent positions into [start, length] pairs
+    int start = positions[0];
+    int length = 1;
+    for (int j = 1; j < query.length; ++j) {
+        if (positions[j] == start + length) {
+            ++length;
+        } else {
+            ranges << start << length;
+            start = positions[j];
+            length = 1;
+        }
+    }
+    ranges << start << length;
+    return ranges;
+}
+
+bool FuzzyMatcher::isSubsequence(const QString &needle, const QString &haystack)
+{
+    qsizetype from = 0;
+    for (QChar ch : needle) {
+        const QChar folded = ch.toCaseFolded();
+        while (from < haystack.size() && haystack.at(from).toCaseFolded() != folded)
+            ++from;
+        if (from == haystack.size())
+            return false;
+        ++from;
+    }
+    return true;
+}
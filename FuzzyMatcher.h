@@ -0,0 +1,87 @@
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <QList>
+#include <QString>
+#include <vector>
+#include "CancelToken.h"
+#include "KeybindStore.h"
+
+// fzf-style subsequence matcher over pre-folded ASCII buffers.
+//
+// build() lays every distinct name, keybind and description string out in
+// one contiguous lower-cased byte buffer, with a parallel buffer of
+// per-position bonuses (word starts, camelCase humps, keybind tokens) and a
+// character mask per string. Scoring is then a mask test, a memchr-driven
+// forward and backward scan and one pass over the matched window, with no
+// allocation.
+// Byte positions map 1:1 to QString indices of the original fields.
+//
+// The matcher holds no query state, so once built it can be read from the
+// filter thread and the GUI thread at the same time.
+class FuzzyMatcher
+{
+public:
+    enum Field {
+        NameField,
+        KeybindField,
+        DescriptionField,
+        FieldCount
+    };
+
+    // Longer queries fall back to substring matching
+    static const int MaxQueryLength = 64;
+
+    // A folded query, prepared once per filter run
+    struct Query {
+        QString text;
+        char pattern[MaxQueryLength] = {};
+        int length = 0;
+        quint64 mask = 0;
+    };
+
+    // (score, item) pairs; rank() reuses one across calls
+    typedef std::vector<std::pair<int, quint32>> Scratch;
+
+    void build(const KeybindStore &store);
+    void clear();
+
+    // Approximate heap usage in bytes
+    qint64 memoryUsage() const;
+
+    // Prepare text as a query; returns false if it cannot be matched here
+    // (empty, too long or containing non-ASCII characters)
+    static bool prepare(const QString &text, Query *query);
+
+    // Best score over all fields, or -1 if the item does not match
+    int score(const Query &query, int item) const;
+
+    // Matching item indices, best score first (ties keep item order).
+    // If candidates is given, only those indices are considered.
+    // Returns false, with result incomplete, if cancel fired.
+    bool rank(const Query &query, const std::vector<quint32> *candidates, std::vector<quint32> *result,
+              Scratch *scratch, const CancelToken &cancel = CancelToken()) const;
+
+    // Matched character ranges of one field as [start, length, ...]
+    QList<int> matchRanges(const Query &query, int item, Field field) const;
+
+    // True if needle is a case-insensitive subsequence of haystack
+    static bool isSubsequence(const QString &needle, const QString &haystack);
+
+private:
+    struct FieldRef {
+        quint32 offset;
+        quint32 length;
+    };
+
+    int scoreField(const Query &query, int item, Field field, int *positions) const;
+    quint32 addString(const QString &text, bool keyToken);
+
+    std::vector<char> m_text;       // Folded ASCII of every distinct string
+    std::vector<quint8> m_bonus;    // Bonus for a match at each position
+    std::vector<FieldRef> m_refs;   // Buffer range per distinct string
+    std::vector<quint64> m_masks;   // Character mask per distinct string
+    std::vector<quint32> m_fields;  // FieldCount string refs per item
+};
+
+#endif // FUZZYMATCHER_H
@@ -0,0 +1,119 @@
+#include "HyprlandIpcSource.h"
+#include "ChordIndex.h"
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QLocalSocket>
+#include <QDebug>
+
+QString HyprlandIpcSource::defaultSocketPath()
+{
+    const QString signature = qEnvironmentVariable("HYPRLAND_INSTANCE_SIGNATURE");
+    if (signature.isEmpty()) {
+        return QString();
+    }
+
+    // Hyprland 0.40 moved its sockets from /tmp/hypr to the runtime dir
+    const QString runtimeDir = qEnvironmentVariable("XDG_RUNTIME_DIR");
+    const QString current = runtimeDir + "/hypr/" + signature + "/.socket.sock";
+    if (!runtimeDir.isEmpty() && QFileInfo::exists(current)) {
+        return current;
+    }
+    const QString legacy = "/tmp/hypr/" + signature + "/.socket.sock";
+    if (QFileInfo::exists(legacy)) {
+        return legacy;
+    }
+    return runtimeDir.isEmpty() ? legacy : current;
+}
+
+// Constructor
+HyprlandIpcSource::HyprlandIpcSource(const QString &socketPath)
+    : m_socketPath(socketPath)
+{
+}
+
+QString HyprlandIpcSource::socketPath() const
+{
+    return m_socketPath;
+}
+
+bool HyprlandIpcSource::isAvailable() const
+{
+    return !m_socketPath.isEmpty() && QFileInfo::exists(m_socketPath);
+}
+
+bool HyprlandIpcSource::fetch(const KeybindParser &parser, const KeybindParser::ItemHandler &handler, int timeoutMs) const
+{
+    if (!isAvailable()) {
+        return false;
+    }
+
+    QLocalSocket socket;
+    socket.connectToServer(m_socketPath);
+    if (!socket.waitForConnected(timeoutMs)) {
+        qWarning() << "Could not connect to Hyprland:" << socket.errorString();
+        return false;
+    }
+
+    socket.write("j/binds");
+    if (!socket.waitForBytesWritten(timeoutMs)) {
+        qWarning() << "Could not send request to Hyprland:" << socket.errorString();
+        return false;
+    }
+
+    // Hyprland writes the reply and closes the connection
+    QByteArray reply;
+    while (socket.waitForReadyRead(timeoutMs)) {
+        reply += socket.readAll();
+    }
+    reply += socket.readAll();
+    if (socket.state() != QLocalSocket::UnconnectedState) {
+        qWarning() << "Hyprland did not finish its reply within" << timeoutMs << "ms";
+        return false;
+    }
+
+    return parseBinds(reply, parser, handler);
+}
+
+bool HyprlandIpcSource::parseBinds(const QByteArray &json, const KeybindParser &parser, const KeybindParser::ItemHandler &handler)
+{
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &error);
+    if (error.error != QJsonParseError::NoError || !document.isArray()) {
+        qWarning() << "Unexpected j/binds reply from Hyprland:" << error.errorString();
+        return false;
+    }
+
+    const QJsonArray binds = document.array();
+    for (const QJsonValue &value : binds) {
+        const QJsonObject bind = value.toObject();
+
+        ConfigEntry entry;
+        entry.type = ConfigEntry::Bind;
+        entry.name = KeyChord::modifierNames(bind.value("modmask").toInt());
+        entry.value = bind.value("key").toString();
+        if (entry.value.isEmpty()) {
+            const int keycode = bind.value("keycode").toInt();
+            entry.value = keycode > 0 ? "code:" + QString::number(keycode) : QString();
+        }
+        entry.dispatcher = bind.value("dispatcher").toString();
+        entry.params = bind.value("arg").toString();
+
+        KeybindItem item = parser.bindItem(entry);
+
+        // bindd lines carry their own description
+        if (bind.value("has_description").toBool()) {
+            item.description = bind.value("description").toString();
+        }
+        const QString submap = bind.value("submap").toString();
+        if (!submap.isEmpty()) {
+            item.keybind = submap + ": " + item.keybind;
+        }
+        handler(item);
+    }
+
+    qDebug() << "Received" << binds.size() << "keybinds from Hyprland";
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef HYPRLANDIPCSOURCE_H
+#define HYPRLANDIPCSOURCE_H
+
+#include <QByteArray>
+#include <QString>
+#include "KeybindParser.h"
+
+// Keybinds as the running compositor sees them.
+//
+// Hyprland answers "j/binds" on its request socket with a JSON array of
+// every active bind, after variables, submaps, bindd descriptions and any
+// runtime "hyprctl keyword bind" changes have been applied. This asks for
+// that list and turns each entry into a KeybindItem the same way a config
+// line would be, so names and icons match the file parser's.
+class HyprlandIpcSource
+{
+public:
+    // Timeout for each socket operation in milliseconds
+    static const int DefaultTimeout = 1000;
+
+    // Request socket of the current Hyprland instance, or an empty string
+    // outside a Hyprland session
+    static QString defaultSocketPath();
+
+    explicit HyprlandIpcSource(const QString &socketPath = defaultSocketPath());
+
+    QString socketPath() const;
+
+    // True if the socket file exists; the compositor may still not answer
+    bool isAvailable() const;
+
+    // Ask for j/binds and pass every bind to handler; returns false if the
+    // socket could not be reached or did not answer with a bind list
+    bool fetch(const KeybindParser &parser, const KeybindParser::ItemHandler &handler,
+               int timeoutMs = DefaultTimeout) const;
+
+    // Parse a j/binds reply
+    static bool parseBinds(const QByteArray &json, const KeybindParser &parser,
+                           const KeybindParser::ItemHandler &handler);
+
+private:
+    QString m_socketPath;
+};
+
+#endif // HYPRLANDIPCSOURCE_H
@@ -0,0 +1,337 @@
+#include "KeyIconProvider.h"
+#include "FileStamp.h"
+#include <QCache>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QImageReader>
+#include <QMutex>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QDebug>
+
+namespace {
+
+// Decoded icons kept in memory, in bytes
+const int MemoryCacheBytes = 4 * 1024 * 1024;
+
+// How long a failed lookup is remembered before it is tried again
+const qint64 FailureRetryMs = 60 * 1000;
+
+// Icons are small; more threads would only contend on the disk
+const int MaxDecodeThreads = 2;
+
+// Theme subdirectories, closest to the display size first
+const char *const ThemeSubdirs[] = {
+    "scalable/apps", "24x24/apps", "32x32/apps", "22x22/apps", "48x48/apps",
+    "16x16/apps", "64x64/apps", "128x128/apps", "256x256/apps",
+    "apps/24", "apps/32", "apps/22", "apps/48", "apps/16", "apps/scalable"
+};
+
+const char *const IconExtensions[] = { ".svg", ".png", ".xpm" };
+
+} // namespace
+
+// State shared between the provider and in-flight responses, which may
+// outlive the provider when the engine is torn down
+class KeyIconCache
+{
+public:
+    explicit KeyIconCache(const QString &thumbnailDir)
+        : m_thumbnailDir(thumbnailDir)
+        , m_images(MemoryCacheBytes)
+        , m_themes({ QIcon::themeName(), QIcon::fallbackThemeName(), QStringLiteral("hicolor") })
+    {
+        m_clock.start();
+        m_themes.removeAll(QString());
+        m_themes.removeDuplicates();
+
+        // ~/.icons first, then every XDG data dir's icons
+        m_iconDirs << QDir::homePath() + "/.icons";
+        m_iconDirs << QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, "icons", QStandardPaths::LocateDirectory);
+    }
+
+    bool cachedImage(const QString &key, QImage *image)
+    {
+        QMutexLocker lock(&m_mutex);
+        const QImage *cached = m_images.object(key);
+        if (!cached) {
+            return false;
+        }
+        *image = *cached;
+        return true;
+    }
+
+    void insertImage(const QString &key, const QImage &image)
+    {
+        QMutexLocker lock(&m_mutex);
+        m_images.insert(key, new QImage(image), int(image.sizeInBytes()));
+    }
+
+    bool recentlyFailed(const QString &id)
+    {
+        QMutexLocker lock(&m_mutex);
+        auto it = m_failures.constFind(id);
+        if (it == m_failures.constEnd()) {
+            return false;
+        }
+        if (m_clock.elapsed() - it.value() > FailureRetryMs) {
+            m_failures.erase(it);
+            return false;
+        }
+        return true;
+    }
+
+    void rememberFailure(const QString &id)
+    {
+        QMutexLocker lock(&m_mutex);
+        m_failures.insert(id, m_clock.elapsed());
+    }
+
+    // Path to decode for an icon id, or an empty string if there is none
+    QString resolve(const QString &id) const
+    {
+        if (id.startsWith("file:") || id.startsWith("qrc:")) {
+            const QUrl url(id);
+            return url.isLocalFile() ? url.toLocalFile() : ":" + url.path();
+        }
+        if (id.startsWith("~/")) {
+            return QDir::homePath() + id.mid(1);
+        }
+        if (id.startsWith(':') || id.contains('/')) {
+            return QFileInfo::exists(id) ? id : QString();
+        }
+        return findThemeIcon(id);
+    }
+
+    // Thumbnail path for a file at a size; empty for files without a stamp
+    QString thumbnailPath(const QString &path, const QSize &size) const
+    {
+        if (m_thumbnailDir.isEmpty() || path.startsWith(':')) {
+            return QString();
+        }
+        const FileStamp stamp = FileStamp::fromPath(path);
+        if (!stamp.exists()) {
+            return QString();
+        }
+        const QByteArray key = QStringLiteral("%1\n%2x%3\n%4 %5 %6")
+            .arg(path).arg(size.width()).arg(size.height())
+            .arg(stamp.size).arg(stamp.mtimeNs).arg(stamp.inode).toUtf8();
+        return m_thumbnailDir + '/' + QString::number(contentHash(key), 16) + ".png";
+    }
+
+    QString thumbnailDir() const
+    {
+        return m_thumbnailDir;
+    }
+
+    // Bytes of decoded icons held in memory, and how many
+    qint64 imageBytes()
+    {
+        QMutexLocker lock(&m_mutex);
+        return qint64(m_images.totalCost());
+    }
+
+    int imageCount()
+    {
+        QMutexLocker lock(&m_mutex);
+        return int(m_images.count());
+    }
+
+private:
+    // Freedesktop icon theme lookup, simplified to the "apps" context
+    QString findThemeIcon(const QString &name) const
+    {
+        for (const QString &theme : m_themes) {
+            for (const QString &base : m_iconDirs) {
+                const QString themeDir = base + '/' + theme + '/';
+                if (!QFileInfo::exists(themeDir)) {
+                    continue;
+                }
+                for (const char *subdir : ThemeSubdirs) {
+                    for (const char *extension : IconExtensions) {
+                        const QString candidate = themeDir + QLatin1String(subdir) + '/' + name + QLatin1String(extension);
+                        if (QFileInfo::exists(candidate)) {
+                            return candidate;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (const char *extension : IconExtensions) {
+            const QString candidate = "/usr/share/pixmaps/" + name + QLatin1String(extension);
+            if (QFileInfo::exists(candidate)) {
+                return candidate;
+            }
+        }
+        return QString();
+    }
+
+    const QString m_thumbnailDir;
+    QMutex m_mutex;
+    QCache<QString, QImage> m_images;
+    QHash<QString, qint64> m_failures;
+    QElapsedTimer m_clock;
+    QStringList m_themes;
+    QStringList m_iconDirs;
+};
+
+namespace {
+
+// One icon request, decoded on the provider's pool
+class KeyIconResponse : public QQuickImageResponse, public QRunnable
+{
+public:
+    KeyIconResponse(const std::shared_ptr<KeyIconCache> &cache, const QString &id, const QSize &size)
+        : m_cache(cache)
+        , m_id(id)
+        , m_size(size)
+    {
+        // Deleted by the engine once finished() has been handled
+        setAutoDelete(false);
+    }
+
+    // Finish with an image from the memory cache without touching the pool
+    void finishWith(const QImage &image)
+    {
+        m_image = image;
+        QMetaObject::invokeMethod(this, &QQuickImageResponse::finished, Qt::QueuedConnection);
+    }
+
+    void run() override
+    {
+        m_image = load();
+        emit finished();
+    }
+
+    QQuickTextureFactory *textureFactory() const override
+    {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+    QString errorString() const override
+    {
+        return m_image.isNull() ? QStringLiteral("Icon not found: ") + m_id : QString();
+    }
+
+    static QString cacheKey(const QString &id, const QSize &size)
+    {
+        return id + QStringLiteral("@%1x%2").arg(size.width()).arg(size.height());
+    }
+
+private:
+    QImage load()
+    {
+        if (m_cache->recentlyFailed(m_id)) {
+            return QImage();
+        }
+
+        const QString path = m_cache->resolve(m_id);
+        if (path.isEmpty()) {
+            m_cache->rememberFailure(m_id);
+            return QImage();
+        }
+
+        const QString thumbnail = m_cache->thumbnailPath(path, m_size);
+        QImage image;
+        if (!thumbnail.isEmpty() && image.load(thumbnail, "PNG")) {
+            m_cache->insertImage(cacheKey(m_id, m_size), image);
+            return image;
+        }
+
+        image = decode(path);
+        if (image.isNull()) {
+            m_cache->rememberFailure(m_id);
+            return image;
+        }
+
+        m_cache->insertImage(cacheKey(m_id, m_size), image);
+        if (!thumbnail.isEmpty()) {
+            QDir().mkpath(m_cache->thumbnailDir());
+            QSaveFile file(thumbnail);
+            if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+                qWarning() << "Could not write icon thumbnail:" << thumbnail;
+            }
+        }
+        return image;
+    }
+
+    // Decode straight to the target size, keeping the aspect ratio
+    QImage decode(const QString &path) const
+    {
+        QImageReader reader(path);
+        const QSize native = reader.size();
+        if (native.isValid()) {
+            reader.setScaledSize(native.scaled(m_size, Qt::KeepAspectRatio));
+        } else {
+            // Vector formats may not report a size; ask for the target directly
+            reader.setScaledSize(m_size);
+        }
+
+        QImage image = reader.read();
+        if (image.isNull()) {
+            qDebug() << "Could not decode icon" << path << reader.errorString();
+        }
+        return image;
+    }
+
+    std::shared_ptr<KeyIconCache> m_cache;
+    QString m_id;
+    QSize m_size;
+    QImage m_image;
+};
+
+} // namespace
+
+// Constructor
+KeyIconProvider::KeyIconProvider(const QString &thumbnailDir)
+    : m_cache(std::make_shared<KeyIconCache>(thumbnailDir))
+{
+    m_pool.setMaxThreadCount(MaxDecodeThreads);
+}
+
+KeyIconProvider::~KeyIconProvider()
+{
+    m_pool.waitForDone();
+}
+
+qint64 KeyIconProvider::cacheBytes() const
+{
+    return m_cache->imageBytes();
+}
+
+int KeyIconProvider::cachedIcons() const
+{
+    return m_cache->imageCount();
+}
+
+QString KeyIconProvider::defaultThumbnailDir()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("icons");
+}
+
+QQuickImageResponse *KeyIconProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    QSize size = requestedSize;
+    if (size.width() <= 0 || size.height() <= 0) {
+        size = QSize(DefaultSize, DefaultSize);
+    }
+
+    // The id is the rest of the URL and may still be percent-encoded
+    const QString icon = QUrl::fromPercentEncoding(id.toUtf8());
+
+    KeyIconResponse *response = new KeyIconResponse(m_cache, icon, size);
+    QImage image;
+    if (m_cache->cachedImage(KeyIconResponse::cacheKey(icon, size), &image)) {
+        response->finishWith(image);
+    } else {
+        m_pool.start(response);
+    }
+    return response;
+}
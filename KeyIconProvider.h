@@ -0,0 +1,40 @@
+#ifndef KEYICONPROVIDER_H
+#define KEYICONPROVIDER_H
+
+#include <QQuickAsyncImageProvider>
+#include <QThreadPool>
+#include <memory>
+
+class KeyIconCache;
+
+// Asynchronous "image://keyicon/<icon>" provider for the keybind list.
+//
+// <icon> is a file path or URL, a resource path, or an icon theme name such
+// as "firefox". Icons are decoded on a small worker pool straight to the
+// requested size (the delegate's sourceSize times the device pixel ratio),
+// so a 512 px PNG never has to be decoded in full. Decoded icons are kept in
+// an LRU memory cache and as PNG thumbnails on disk, and lookups that failed
+// are remembered for a while instead of being retried by every delegate.
+class KeyIconProvider : public QQuickAsyncImageProvider
+{
+public:
+    // Size used when the delegate does not set sourceSize
+    static const int DefaultSize = 20;
+
+    explicit KeyIconProvider(const QString &thumbnailDir = defaultThumbnailDir());
+    ~KeyIconProvider() override;
+
+    static QString defaultThumbnailDir();
+
+    // Decoded icons in the memory cache, for --memstats
+    qint64 cacheBytes() const;
+    int cachedIcons() const;
+
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+private:
+    std::shared_ptr<KeyIconCache> m_cache;
+    QThreadPool m_pool;
+};
+
+#endif // KEYICONPROVIDER_H
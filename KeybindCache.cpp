@@ -0,0 +1,281 @@
+#include "KeybindCache.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QHash>
+#include <QStandardPaths>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+const char CacheMagic[4] = { 'H', 'K', 'B', 'C' };
+
+// All records are 8-byte aligned so the mapped file can be read in place
+struct Header {
+    char magic[4];
+    quint32 version;
+    quint32 fileCount;
+    quint32 itemCount;
+    quint32 blobLength;     // UTF-16 code units in the string blob
+    quint32 configOffset;   // Selected config path inside the blob
+    quint32 configLength;
+    quint32 sourceOffset;   // Source of the list inside the blob
+    quint32 sourceLength;
+    quint32 reserved;
+};
+
+struct FileRecord {
+    qint64 size;
+    qint64 mtimeNs;
+    quint64 inode;
+    quint32 pathOffset;
+    quint32 pathLength;
+};
+
+struct ItemRecord {
+    quint32 offset[5];      // name, keybind, description, icon, dispatcher
+    quint32 length[5];
+};
+
+static_assert(sizeof(Header) == 40, "unexpected cache header size");
+static_assert(sizeof(FileRecord) == 32, "unexpected cache file record size");
+static_assert(sizeof(ItemRecord) == 40, "unexpected cache item record size");
+
+// Collects strings into one blob, storing repeated strings only once
+class BlobWriter
+{
+public:
+    void add(const QString &text, quint32 *offset, quint32 *length)
+    {
+        auto it = m_offsets.constFind(text);
+        if (it == m_offsets.constEnd()) {
+            it = m_offsets.insert(text, quint32(m_blob.size()));
+            m_blob.append(text);
+        }
+        *offset = it.value();
+        *length = quint32(text.size());
+    }
+
+    const QString &blob() const { return m_blob; }
+
+private:
+    QString m_blob;
+    QHash<QString, quint32> m_offsets;
+};
+
+} // namespace
+
+// Constructor
+KeybindCache::KeybindCache(const QString &cachePath)
+    : m_cachePath(cachePath)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+QString KeybindCache::defaultPath()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("keybinds.cache");
+}
+
+QString KeybindCache::cachePath() const
+{
+    return m_cachePath;
+}
+
+int KeybindCache::hits() const
+{
+    return m_hits;
+}
+
+int KeybindCache::misses() const
+{
+    return m_misses;
+}
+
+bool KeybindCache::load(const QString &configPath, const QString &source, QList<KeybindItem> *items,
+                        QStringList *inputFiles)
+{
+    QFile file(m_cachePath);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < qint64(sizeof(Header))) {
+        ++m_misses;
+        return false;
+    }
+
+    const qint64 fileSize = file.size();
+    const uchar *base = file.map(0, fileSize);
+    if (!base) {
+        ++m_misses;
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, base, sizeof(Header));
+
+    const qint64 expectedSize = qint64(sizeof(Header))
+        + qint64(header.fileCount) * qint64(sizeof(FileRecord))
+        + qint64(header.itemCount) * qint64(sizeof(ItemRecord))
+        + qint64(header.blobLength) * qint64(sizeof(char16_t));
+
+    if (std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0
+        || header.version != FormatVersion
+        || expectedSize != fileSize) {
+        qDebug() << "Keybind cache is stale or from another version:" << m_cachePath;
+        ++m_misses;
+        return false;
+    }
+
+    const FileRecord *files = reinterpret_cast<const FileRecord *>(base + sizeof(Header));
+    const ItemRecord *records = reinterpret_cast<const ItemRecord *>(files + header.fileCount);
+    const QChar *blob = reinterpret_cast<const QChar *>(records + header.itemCount);
+
+    auto inBlob = [&](quint32 offset, quint32 length) {
+        return quint64(offset) + quint64(length) <= quint64(header.blobLength);
+    };
+
+    // The selected config must be the same file as last time
+    if (!inBlob(header.configOffset, header.configLength)
+        || QString(blob + header.configOffset, header.configLength) != configPath) {
+        qDebug() << "Keybind cache miss: config path changed";
+        ++m_misses;
+        return false;
+    }
+
+    // A parsed list must not answer for the compositor's, nor the reverse
+    if (!inBlob(header.sourceOffset, header.sourceLength)
+        || QString(blob + header.sourceOffset, header.sourceLength) != source) {
+        qDebug() << "Keybind cache miss: keybind source changed";
+        ++m_misses;
+        return false;
+    }
+
+    // Every recorded input must be unchanged
+    QStringList recordedFiles;
+    for (quint32 i = 0; i < header.fileCount; ++i) {
+        const FileRecord &record = files[i];
+        if (!inBlob(record.pathOffset, record.pathLength)) {
+            ++m_misses;
+            return false;
+        }
+
+        FileStamp recorded;
+        recorded.path = QString(blob + record.pathOffset, record.pathLength);
+        recorded.size = record.size;
+        recorded.mtimeNs = record.mtimeNs;
+        recorded.inode = record.inode;
+
+        if (FileStamp::fromPath(recorded.path) != recorded) {
+            qDebug() << "Keybind cache miss: input changed:" << recorded.path;
+            ++m_misses;
+            return false;
+        }
+        recordedFiles.append(recorded.path);
+    }
+
+    // Materialize the items, sharing repeated strings between them
+    QList<KeybindItem> result;
+    result.reserve(header.itemCount);
+    QHash<quint32, QString> strings;
+
+    auto stringAt = [&](quint32 offset, quint32 length) -> QString {
+        if (length == 0)
+            return QString();
+        auto it = strings.constFind(offset);
+        if (it == strings.constEnd())
+            it = strings.insert(offset, QString(blob + offset, length));
+        return it.value();
+    };
+
+    for (quint32 i = 0; i < header.itemCount; ++i) {
+        const ItemRecord &record = records[i];
+        for (int field = 0; field < 5; ++field) {
+            if (!inBlob(record.offset[field], record.length[field])) {
+                ++m_misses;
+                return false;
+            }
+        }
+
+        KeybindItem item;
+        item.name = stringAt(record.offset[0], record.length[0]);
+        item.keybind = stringAt(record.offset[1], record.length[1]);
+        item.description = stringAt(record.offset[2], record.length[2]);
+        item.icon = stringAt(record.offset[3], record.length[3]);
+        item.dispatcher = stringAt(record.offset[4], record.length[4]);
+        result.append(item);
+    }
+
+    file.unmap(const_cast<uchar *>(base));
+
+    *items = result;
+    if (inputFiles) {
+        *inputFiles = recordedFiles;
+    }
+    ++m_hits;
+    qDebug() << "Keybind cache hit:" << result.size() << "keybinds from" << m_cachePath;
+    return true;
+}
+
+bool KeybindCache::store(const QString &configPath, const QString &source, const QStringList &inputFiles,
+                         const QList<KeybindItem> &items)
+{
+    BlobWriter blob;
+
+    Header header;
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.version = FormatVersion;
+    header.fileCount = quint32(inputFiles.size());
+    header.itemCount = quint32(items.size());
+    header.reserved = 0;
+    blob.add(configPath, &header.configOffset, &header.configLength);
+    blob.add(source, &header.sourceOffset, &header.sourceLength);
+
+    QList<FileRecord> files;
+    files.reserve(inputFiles.size());
+    for (const QString &path : inputFiles) {
+        FileStamp stamp = FileStamp::fromPath(path);
+        FileRecord record;
+        record.size = stamp.size;
+        record.mtimeNs = stamp.mtimeNs;
+        record.inode = stamp.inode;
+        blob.add(path, &record.pathOffset, &record.pathLength);
+        files.append(record);
+    }
+
+    QList<ItemRecord> records;
+    records.reserve(items.size());
+    for (const KeybindItem &item : items) {
+        ItemRecord record;
+        blob.add(item.name, &record.offset[0], &record.length[0]);
+        blob.add(item.keybind, &record.offset[1], &record.length[1]);
+        blob.add(item.description, &record.offset[2], &record.length[2]);
+        blob.add(item.icon, &record.offset[3], &record.length[3]);
+        blob.add(item.dispatcher, &record.offset[4], &record.length[4]);
+        records.append(record);
+    }
+
+    header.blobLength = quint32(blob.blob().size());
+
+    QDir().mkpath(QFileInfo(m_cachePath).absolutePath());
+
+    // Write to a temporary file and rename, so readers never see a torn cache
+    QSaveFile file(m_cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write keybind cache:" << m_cachePath;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char *>(files.constData()), files.size() * qint64(sizeof(FileRecord)));
+    file.write(reinterpret_cast<const char *>(records.constData()), records.size() * qint64(sizeof(ItemRecord)));
+    file.write(reinterpret_cast<const char *>(blob.blob().constData()), blob.blob().size() * qint64(sizeof(char16_t)));
+
+    if (!file.commit()) {
+        qWarning() << "Could not write keybind cache:" << m_cachePath;
+        return false;
+    }
+
+    qDebug() << "Keybind cache written:" << items.size() << "keybinds to" << m_cachePath;
+    return true;
+}
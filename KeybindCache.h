@@ -0,0 +1,49 @@
+#ifndef KEYBINDCACHE_H
+#define KEYBINDCACHE_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include "KeybindItem.h"
+#include "FileStamp.h"
+
+// On-disk binary snapshot of the parsed keybind list.
+//
+// The file is laid out so it can be mapped and read in place:
+//   Header | FileRecord[fileCount] | ItemRecord[itemCount] | UTF-16 string blob
+// It is only valid while the selected config path, the source of the list
+// and the size, mtime and inode of every input file still match what was
+// recorded. The source is empty for a list parsed from the config files and
+// the Hyprland socket path for one fetched over IPC, so one never stands in
+// for the other.
+class KeybindCache
+{
+public:
+    // Bump whenever the on-disk layout or the parser output changes
+    static const quint32 FormatVersion = 6;
+
+    explicit KeybindCache(const QString &cachePath = defaultPath());
+
+    static QString defaultPath();
+    QString cachePath() const;
+
+    // Fill items from the snapshot if it is still valid for configPath and
+    // was made from source; inputFiles receives the recorded input paths
+    bool load(const QString &configPath, const QString &source, QList<KeybindItem> *items,
+              QStringList *inputFiles = nullptr);
+
+    // Write a fresh snapshot of items from source, keyed by the given input files
+    bool store(const QString &configPath, const QString &source, const QStringList &inputFiles,
+               const QList<KeybindItem> &items);
+
+    // Counters for the current process
+    int hits() const;
+    int misses() const;
+
+private:
+    QString m_cachePath;
+    int m_hits;
+    int m_misses;
+};
+
+#endif // KEYBINDCACHE_H
@@ -0,0 +1,128 @@
+#include "KeybindFilter.h"
+#include <QElapsedTimer>
+
+void KeybindFilter::Indexes::build(const KeybindStore &store)
+{
+    search.build(store);
+    fuzzy.build(store);
+    chords.build(store);
+    sort.build(store);
+}
+
+bool KeybindFilter::run(const IndexesPtr &indexes, const Request &request, const CancelToken &cancel, Result *result)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    result->indexes = indexes;
+    result->request = request;
+    result->indices.clear();
+    result->query = FuzzyMatcher::Query();
+    result->fuzzy = false;
+
+    // State from other indexes refers to items that may not exist any more
+    if (m_indexes != indexes) {
+        reset();
+        m_indexes = indexes;
+    }
+
+    if (request.chord.isValid()) {
+        // A pressed chord replaces the text filter
+        result->indices = indexes->chords.find(request.chord);
+    } else if (request.text.isEmpty()) {
+        // If no filter text, show all items
+        result->indices.resize(size_t(request.itemCount));
+        for (size_t i = 0; i < result->indices.size(); ++i) {
+            result->indices[i] = quint32(i);
+        }
+    } else {
+        const bool fuzzy = request.fuzzy && FuzzyMatcher::prepare(request.text, &result->query);
+        result->query.text = request.text;
+        result->fuzzy = fuzzy;
+
+        // A query that extends the previous one can only narrow its result;
+        // the previous order is kept, so the sort mode has to match too
+        const std::vector<quint32> *candidates = nullptr;
+        if (!m_text.isEmpty() && fuzzy == m_fuzzy
+            && request.sortKey == m_sortKey && request.descending == m_descending) {
+            const bool narrows = fuzzy
+                ? FuzzyMatcher::isSubsequence(m_text, request.text)
+                : request.text.contains(m_text, Qt::CaseInsensitive);
+            if (narrows) {
+                candidates = &m_previous;
+            }
+        }
+
+        const bool complete = fuzzy
+            ? indexes->fuzzy.rank(result->query, candidates, &result->indices, &m_scratch, cancel)
+            : indexes->search.search(request.text, candidates, &result->indices, cancel);
+        if (!complete) {
+            return false;
+        }
+    }
+
+    if (cancel.cancelled()) {
+        return false;
+    }
+    if (request.sortKey >= 0) {
+        indexes->sort.sort(&result->indices, KeybindSortIndex::Key(request.sortKey), request.descending);
+    }
+
+    // Only text results can be narrowed later
+    m_text = request.chord.isValid() ? QString() : request.text;
+    m_fuzzy = result->fuzzy;
+    m_sortKey = request.sortKey;
+    m_descending = request.descending;
+    if (!m_text.isEmpty()) {
+        m_previous = result->indices;
+    } else {
+        m_previous.clear();
+    }
+
+    result->elapsedNs = timer.nsecsElapsed();
+    return true;
+}
+
+void KeybindFilter::reset()
+{
+    m_indexes.reset();
+    m_text.clear();
+    m_fuzzy = false;
+    m_sortKey = -1;
+    m_descending = false;
+    m_previous.clear();
+}
+
+qint64 KeybindFilter::memoryUsage() const
+{
+    return qint64(m_previous.capacity()) * qint64(sizeof(quint32))
+         + qint64(m_scratch.capacity()) * qint64(sizeof(FuzzyMatcher::Scratch::value_type));
+}
+
+// Constructor
+KeybindFilterWorker::KeybindFilterWorker(QObject *parent)
+    : QObject(parent)
+    , m_latest(0)
+{
+}
+
+void KeybindFilterWorker::supersede(quint64 generation)
+{
+    m_latest.store(generation, std::memory_order_relaxed);
+}
+
+void KeybindFilterWorker::filter(quint64 generation, const KeybindFilter::IndexesPtr &indexes,
+                                 const KeybindFilter::Request &request)
+{
+    // Requests queue up while typing; all but the newest are dropped here
+    const CancelToken cancel(&m_latest, generation);
+    if (cancel.cancelled()) {
+        return;
+    }
+
+    auto result = std::make_shared<KeybindFilter::Result>();
+    result->generation = generation;
+    if (m_filter.run(indexes, request, cancel, result.get())) {
+        emit filtered(result);
+    }
+}
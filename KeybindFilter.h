@@ -0,0 +1,108 @@
+#ifndef KEYBINDFILTER_H
+#define KEYBINDFILTER_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "CancelToken.h"
+#include "ChordIndex.h"
+#include "FuzzyMatcher.h"
+#include "KeybindSearchIndex.h"
+#include "KeybindSortIndex.h"
+#include "KeybindStore.h"
+
+// One filter run: text or chord matching followed by the sort mode.
+//
+// Everything a run reads is bundled in Indexes, built once per keybind list
+// and never modified afterwards, so the GUI thread and the filter thread can
+// share it through a shared_ptr. The runner itself remembers its last
+// result, so a query that extends the previous one only narrows it.
+class KeybindFilter
+{
+public:
+    // Search structures of one keybind list
+    struct Indexes {
+        KeybindSearchIndex search;
+        FuzzyMatcher fuzzy;
+        ChordIndex chords;
+        KeybindSortIndex sort;
+
+        void build(const KeybindStore &store);
+    };
+    typedef std::shared_ptr<const Indexes> IndexesPtr;
+
+    struct Request {
+        int itemCount = 0;          // Items shown when nothing filters
+        QString text;
+        bool fuzzy = false;         // Rank fuzzily where the text allows it
+        KeyChord chord;             // Replaces the text when valid
+        int sortKey = -1;           // KeybindSortIndex::Key, -1 for none
+        bool descending = false;
+        bool keepPosition = false;  // Same query as shown, only the sort changed
+    };
+
+    struct Result {
+        quint64 generation = 0;
+        IndexesPtr indexes;             // Indexes the result refers to
+        std::vector<quint32> indices;   // Matching items in display order
+        FuzzyMatcher::Query query;      // Text matched, empty for none or a chord
+        bool fuzzy = false;             // Ranked fuzzily rather than by substring
+        Request request;                // Settings the run was made with
+        qint64 elapsedNs = 0;
+    };
+    typedef std::shared_ptr<Result> ResultPtr;
+
+    // Fill result for request; returns false, leaving the narrowing state
+    // as it was, if cancel fired first
+    bool run(const IndexesPtr &indexes, const Request &request, const CancelToken &cancel, Result *result);
+
+    // Forget the previous result, so the next run starts from every item
+    void reset();
+
+    // Heap bytes kept for narrowing and ranking the next run
+    qint64 memoryUsage() const;
+
+private:
+    IndexesPtr m_indexes;           // Indexes m_previous refers to
+    QString m_text;                 // Query that produced m_previous
+    bool m_fuzzy = false;
+    int m_sortKey = -1;
+    bool m_descending = false;
+    std::vector<quint32> m_previous;
+    FuzzyMatcher::Scratch m_scratch;
+};
+
+Q_DECLARE_METATYPE(KeybindFilter::IndexesPtr)
+Q_DECLARE_METATYPE(KeybindFilter::Request)
+Q_DECLARE_METATYPE(KeybindFilter::ResultPtr)
+
+// Runs filters on KeybindModel's filter thread.
+//
+// Every request carries a generation. supersede() may be called from any
+// thread; it makes every older request stale, so a run still queued is
+// dropped and a running one stops at its next cancellation check. Only
+// completed runs are reported.
+class KeybindFilterWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit KeybindFilterWorker(QObject *parent = nullptr);
+
+    // Mark every request older than generation as stale
+    void supersede(quint64 generation);
+
+public slots:
+    void filter(quint64 generation, const KeybindFilter::IndexesPtr &indexes, const KeybindFilter::Request &request);
+
+signals:
+    void filtered(const KeybindFilter::ResultPtr &result);
+
+private:
+    KeybindFilter m_filter;
+    std::atomic<quint64> m_latest;  // Newest generation requested
+};
+
+#endif // KEYBINDFILTER_H
@@ -0,0 +1,18 @@
+#ifndef KEYBINDITEM_H
+#define KEYBINDITEM_H
+
+#include <QMetaType>
+#include <QString>
+
+// Structure to hold keybind data
+struct KeybindItem {
+    QString name;
+    QString keybind;
+    QString description;
+    QString icon;
+    QString dispatcher;     // Hyprland dispatcher the bind runs, e.g. "exec"
+};
+
+Q_DECLARE_METATYPE(KeybindItem)
+
+#endif // KEYBINDITEM_H
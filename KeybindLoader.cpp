@@ -0,0 +1,260 @@
+#include "KeybindLoader.h"
+#include "KeybindParser.h"
+#include "StartupTrace.h"
+#include <QDebug>
+#include <algorithm>
+
+// Constructor
+KeybindLoader::KeybindLoader(QObject *parent)
+    : QObject(parent)
+    , m_ipcSocketPath(HyprlandIpcSource::defaultSocketPath())
+{
+    m_parser.setDesktopEntries(&m_desktopEntries);
+}
+
+void KeybindLoader::setConfigPath(const QString &path)
+{
+    m_requestedConfigPath = path;
+}
+
+void KeybindLoader::setIpcSocketPath(const QString &path)
+{
+    m_ipcSocketPath = path;
+}
+
+// The explicitly requested config, or the first one found in the default locations
+QString KeybindLoader::resolveConfigPath() const
+{
+    if (!m_requestedConfigPath.isEmpty()) {
+        return m_requestedConfigPath;
+    }
+    return KeybindParser::findConfigFile();
+}
+
+void KeybindLoader::load(quint64 generation)
+{
+    qint64 traceStart = StartupTrace::now();
+    QString configPath = resolveConfigPath();
+    StartupTrace::complete("config discovery", traceStart);
+    m_configPath = configPath;
+    resetParser();
+
+    QList<KeybindItem> items;
+    if (configPath.isEmpty()) {
+        // Without a config file only the compositor knows the binds
+        if (fetchFromCompositor(&items)) {
+            deliver(generation, items);
+            emit finished(generation, false, watchedFiles(), buildIndexes(items));
+            return;
+        }
+        qWarning() << "Config file not found at any expected location. Loading sample data.";
+        items = KeybindParser::sampleData();
+        deliver(generation, items);
+        emit finished(generation, false, QStringList(), buildIndexes(items));
+        return;
+    }
+
+    // Inside a session the compositor's own list is exact, so it is asked
+    // before the cache. The config is still parsed once, for the sourced
+    // files to watch. The list is not cached: the snapshot only ever holds
+    // parsed binds, for --no-ipc, --config and sessions without a socket.
+    if (fetchFromCompositor(&items)) {
+        deliver(generation, items);
+        if (parseSourceFiles(configPath, QStringList())) {
+            emit finished(generation, false, inputFiles(), buildIndexes(items));
+        } else {
+            emit finished(generation, false, watchedFiles(), buildIndexes(items));
+        }
+        return;
+    }
+
+    // Cache hit: nothing to parse
+    QStringList sourceFiles;
+    traceStart = StartupTrace::now();
+    const bool cacheHit = m_cache.load(configPath, QString(), &items, &sourceFiles);
+    StartupTrace::complete("keybind cache", traceStart);
+    if (cacheHit) {
+        deliver(generation, items);
+        emit finished(generation, true, sourceFiles, buildIndexes(items));
+        return;
+    }
+
+    // Cache miss: stream items while parsing, then write a fresh snapshot
+    QList<KeybindItem> batch;
+    batch.reserve(FirstBatchSize);
+    int batchLimit = FirstBatchSize;
+
+    if (!m_desktopEntries.isLoaded()) {
+        traceStart = StartupTrace::now();
+        m_desktopEntries.load();
+        StartupTrace::complete("desktop entries", traceStart);
+    }
+
+    traceStart = StartupTrace::now();
+    bool parsed = m_parser.parseFile(configPath, [&](const KeybindItem &item) {
+        items.append(item);
+        batch.append(item);
+        if (batch.size() >= batchLimit) {
+            emit batchReady(generation, batch);
+            batch.clear();
+            batchLimit = BatchSize;
+        }
+    });
+    StartupTrace::complete("parseConfigFile", traceStart);
+
+    if (!parsed) {
+        items = KeybindParser::sampleData();
+        deliver(generation, items);
+        emit finished(generation, false, QStringList { configPath }, buildIndexes(items));
+        return;
+    }
+
+    if (!batch.isEmpty()) {
+        emit batchReady(generation, batch);
+    }
+    m_cache.store(configPath, QString(), inputFiles(), items);
+    emit finished(generation, false, inputFiles(), buildIndexes(items));
+}
+
+void KeybindLoader::reload(quint64 generation, const QStringList &changedPaths)
+{
+    // The config selection itself may have changed
+    const QString configPath = resolveConfigPath();
+    if (configPath != m_configPath) {
+        m_configPath = configPath;
+        resetParser();
+    }
+
+    // Installed or removed applications rename exec binds in every file,
+    // which the replay below picks up
+    const QStringList desktopInputs = m_desktopEntries.inputPaths();
+    const bool desktopChanged = std::any_of(changedPaths.cbegin(), changedPaths.cend(), [&](const QString &path) {
+        return desktopInputs.contains(path);
+    });
+    if (desktopChanged || !m_desktopEntries.isLoaded()) {
+        m_desktopEntries.load();
+    }
+
+    // The sourced files are re-read as well, so added or removed
+    // "source =" files are watched in IPC mode too. Nothing is cached:
+    // Hyprland may not have applied the changed files yet.
+    QList<KeybindItem> items;
+    if (fetchFromCompositor(&items)) {
+        if (parseSourceFiles(configPath, changedPaths)) {
+            emit reloaded(generation, items, inputFiles(), buildIndexes(items));
+        } else {
+            emit reloaded(generation, items, watchedFiles(), buildIndexes(items));
+        }
+        return;
+    }
+
+    auto collect = [&items](const KeybindItem &item) {
+        items.append(item);
+    };
+
+    // After a cache hit nothing is tokenized yet, so parse everything once
+    bool parsed = !configPath.isEmpty() && m_parser.reparseFiles(changedPaths, collect);
+    if (!parsed && !configPath.isEmpty()) {
+        items.clear();
+        parsed = m_parser.parseFile(configPath, collect);
+    }
+    if (!parsed) {
+        const QList<KeybindItem> sample = KeybindParser::sampleData();
+        emit reloaded(generation, sample, QStringList { configPath }, buildIndexes(sample));
+        return;
+    }
+
+    m_cache.store(configPath, QString(), inputFiles(), items);
+    emit reloaded(generation, items, inputFiles(), buildIndexes(items));
+}
+
+void KeybindLoader::resetParser()
+{
+    m_parser = KeybindParser();
+    m_parser.setDesktopEntries(&m_desktopEntries);
+}
+
+// Ask a running Hyprland for its binds, unless a config file was requested
+bool KeybindLoader::fetchFromCompositor(QList<KeybindItem> *items)
+{
+    if (!m_requestedConfigPath.isEmpty() || m_ipcSocketPath.isEmpty()) {
+        return false;
+    }
+    const HyprlandIpcSource source(m_ipcSocketPath);
+    if (!source.isAvailable()) {
+        return false;
+    }
+
+    if (!m_desktopEntries.isLoaded()) {
+        m_desktopEntries.load();
+    }
+
+    items->clear();
+    StartupTrace::Scope trace("hyprland ipc");
+    const bool fetched = source.fetch(m_parser, [items](const KeybindItem &item) {
+        items->append(item);
+    });
+    if (!fetched) {
+        qWarning() << "Falling back to parsing the config file";
+        items->clear();
+    }
+    return fetched;
+}
+
+// Parse the config without collecting items, only to learn its source
+// files; only the changed files are read again once it has been tokenized
+bool KeybindLoader::parseSourceFiles(const QString &configPath, const QStringList &changedPaths)
+{
+    if (configPath.isEmpty()) {
+        return false;
+    }
+    const auto ignore = [](const KeybindItem &) {};
+    StartupTrace::Scope trace("config source files");
+    if (!changedPaths.isEmpty() && m_parser.reparseFiles(changedPaths, ignore)) {
+        return true;
+    }
+    return m_parser.parseFile(configPath, ignore);
+}
+
+// Files whose change should refresh binds fetched over IPC when the
+// config could not be parsed for its source files
+QStringList KeybindLoader::watchedFiles() const
+{
+    QStringList files = m_desktopEntries.inputPaths();
+    if (!m_configPath.isEmpty()) {
+        files.prepend(m_configPath);
+    }
+    return files;
+}
+
+// Config files plus everything the desktop entry index was built from
+QStringList KeybindLoader::inputFiles() const
+{
+    return m_parser.sourceFiles() + m_desktopEntries.inputPaths();
+}
+
+// Filter indexes of items in delivery order, so they line up with the
+// store the model fills from the batches. Built here rather than on the
+// GUI thread: the trigram, fuzzy and chord indexes and the collation ranks
+// take long enough on large configs to drop frames.
+KeybindFilter::IndexesPtr KeybindLoader::buildIndexes(const QList<KeybindItem> &items)
+{
+    StartupTrace::Scope trace("build indexes");
+    KeybindStore store;
+    store.append(items);
+    auto indexes = std::make_shared<KeybindFilter::Indexes>();
+    indexes->build(store);
+    return indexes;
+}
+
+// Emit items in batches of the usual sizes
+void KeybindLoader::deliver(quint64 generation, const QList<KeybindItem> &items)
+{
+    int batchLimit = FirstBatchSize;
+    for (int start = 0; start < items.size(); start += batchLimit) {
+        if (start > 0) {
+            batchLimit = BatchSize;
+        }
+        emit batchReady(generation, items.mid(start, batchLimit));
+    }
+}
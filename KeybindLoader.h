@@ -0,0 +1,73 @@
+#ifndef KEYBINDLOADER_H
+#define KEYBINDLOADER_H
+
+#include <QObject>
+#include <QList>
+#include <QStringList>
+#include "KeybindItem.h"
+#include "KeybindCache.h"
+#include "KeybindFilter.h"
+#include "KeybindParser.h"
+#include "DesktopEntryIndex.h"
+#include "HyprlandIpcSource.h"
+
+// Worker that loads keybinds off the GUI thread.
+//
+// It lives on KeybindModel's loader thread. Inside a Hyprland session it
+// asks the compositor for its binds over IPC. Otherwise, or when an explicit
+// config file was requested, it tries the binary cache of the parsed config
+// and parses the config file on a miss. Items are delivered in batches so
+// the first page can be shown before parsing has finished, and the filter
+// indexes of the complete list are built here and sent with the result. The parser keeps
+// its per-file tokens, so a reload only re-reads the files that changed.
+// Calling load() directly runs it synchronously on the calling thread.
+class KeybindLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // The first batch is small so the first page paints quickly
+    static const int FirstBatchSize = 64;
+    static const int BatchSize = 4096;
+
+    explicit KeybindLoader(QObject *parent = nullptr);
+
+public slots:
+    // Read path instead of searching the default locations; empty to search again
+    void setConfigPath(const QString &path);
+
+    // Hyprland request socket to ask for binds; empty to always parse files
+    void setIpcSocketPath(const QString &path);
+
+    // Load all keybinds; generation is echoed back in every signal
+    void load(quint64 generation);
+
+    // Re-parse after changedPaths were modified and deliver the full list at once
+    void reload(quint64 generation, const QStringList &changedPaths);
+
+signals:
+    void batchReady(quint64 generation, const QList<KeybindItem> &items);
+    void finished(quint64 generation, bool cacheHit, const QStringList &sourceFiles,
+                  const KeybindFilter::IndexesPtr &indexes);
+    void reloaded(quint64 generation, const QList<KeybindItem> &items, const QStringList &sourceFiles,
+                  const KeybindFilter::IndexesPtr &indexes);
+
+private:
+    void deliver(quint64 generation, const QList<KeybindItem> &items);
+    static KeybindFilter::IndexesPtr buildIndexes(const QList<KeybindItem> &items);
+    QString resolveConfigPath() const;
+    void resetParser();
+    bool fetchFromCompositor(QList<KeybindItem> *items);
+    bool parseSourceFiles(const QString &configPath, const QStringList &changedPaths);
+    QStringList inputFiles() const;
+    QStringList watchedFiles() const;
+
+    KeybindCache m_cache;
+    KeybindParser m_parser;
+    DesktopEntryIndex m_desktopEntries;  // Loaded on the first parse
+    QString m_configPath;           // Config file of the current keybinds
+    QString m_requestedConfigPath;  // Explicit config file, if any
+    QString m_ipcSocketPath;        // Hyprland socket, empty when disabled
+};
+
+#endif // KEYBINDLOADER_H
@@ -1,13 +1,87 @@
 #include "KeybindModel.h"
+#include "KeybindLoader.h"
+#include "StartupTrace.h"
 #include <QDir>
+#include <QSet>
 #include <QStandardPaths>
+#include <algorithm>
 
 // Constructor
 KeybindModel::KeybindModel(QObject *parent)
     : QAbstractListModel(parent)
     , m_currentPage(0)
     , m_itemsPerPage(7)
+    , m_indexes(std::make_shared<KeybindFilter::Indexes>())
+    , m_matchFuzzy(false)
+    , m_fuzzyMatching(true)
+    , m_sortRole(0)
+    , m_sortOrder(Qt::AscendingOrder)
+    , m_viewHeight(0)
+    , m_continuousScroll(false)
+    , m_fetchLimit(FetchChunk)
+    , m_totalPages(0)
+    , m_syncPending(false)
+    , m_filterDirty(false)
+    , m_rangesDirty(false)
+    , m_filterWorker(new KeybindFilterWorker)
+    , m_filterGeneration(0)
+    , m_filterRunning(false)
+    , m_lastFilterNs(0)
+    , m_loader(new KeybindLoader)
+    , m_loadGeneration(0)
+    , m_loading(false)
+    , m_cacheHits(0)
+    , m_cacheMisses(0)
 {
+    qRegisterMetaType<QList<KeybindItem>>();
+    qRegisterMetaType<KeybindFilter::IndexesPtr>("KeybindFilter::IndexesPtr");
+    qRegisterMetaType<KeybindFilter::Request>("KeybindFilter::Request");
+    qRegisterMetaType<KeybindFilter::ResultPtr>("KeybindFilter::ResultPtr");
+
+    // The loader lives on its own thread and reports back through queued signals
+    m_loader->moveToThread(&m_loaderThread);
+    connect(&m_loaderThread, &QThread::finished, m_loader, &QObject::deleteLater);
+    connect(m_loader, &KeybindLoader::batchReady, this, &KeybindModel::appendBatch);
+    connect(m_loader, &KeybindLoader::finished, this, &KeybindModel::finishLoading);
+    connect(m_loader, &KeybindLoader::reloaded, this, &KeybindModel::mergeKeybinds);
+
+    // Filters run on a second thread so typing never waits for one
+    m_filterWorker->moveToThread(&m_filterThread);
+    connect(&m_filterThread, &QThread::finished, m_filterWorker, &QObject::deleteLater);
+    connect(m_filterWorker, &KeybindFilterWorker::filtered, this, &KeybindModel::applyFilterResult);
+
+    m_filterTimer.setSingleShot(true);
+    connect(&m_filterTimer, &QTimer::timeout, this, &KeybindModel::startFilter);
+}
+
+// Destructor
+KeybindModel::~KeybindModel()
+{
+    if (m_loaderThread.isRunning()) {
+        m_loaderThread.quit();
+        m_loaderThread.wait();
+    } else {
+        // Never started, so the thread cannot delete it
+        delete m_loader;
+    }
+
+    if (m_filterThread.isRunning()) {
+        // Stop a running filter at its next check
+        m_filterWorker->supersede(++m_filterGeneration);
+        m_filterThread.quit();
+        m_filterThread.wait();
+    } else {
+        delete m_filterWorker;
+    }
+}
+
+// The loader thread is only started once something has to be loaded, so
+// models filled with setKeybinds() never spawn it
+void KeybindModel::startLoaderThread()
+{
+    if (!m_loaderThread.isRunning()) {
+        m_loaderThread.start();
+    }
 }
 
 // Return the number of rows in the current view
@@ -16,10 +90,7 @@ int KeybindModel::rowCount(const QModelIndex &parent) const
     if (parent.isValid())
         return 0;
 
-    // Calculate the range of items for the current page
-    int start = m_currentPage * m_itemsPerPage;
-    int end = qMin(start + m_itemsPerPage, m_filteredKeybinds.size());
-    return end - start;
+    return int(m_visibleRows.size());
 }
 
 // Return data for a specific index and role
@@ -28,23 +99,37 @@ QVariant KeybindModel::data(const QModelIndex &index, int role) const
     if (!index.isValid() || index.row() >= rowCount())
         return QVariant();
 
-    // Calculate the actual index in the filtered list
-    int actualIndex = index.row() + (m_currentPage * m_itemsPerPage);
-    if (actualIndex >= m_filteredKeybinds.size())
+    // Rows of a reload in progress may briefly hold ids of removed items
+    const quint32 item = m_visibleRows[index.row()];
+    if (item >= quint32(m_store.size()))
         return QVariant();
+    const int itemIndex = int(item);
 
-    const KeybindItem &item = m_filteredKeybinds.at(actualIndex);
-
-    // Return data based on the requested role
+    // Return data based on the requested role; the interned strings are shared, not copied
     switch (role) {
     case NameRole:
-        return item.name;
+        return m_store.text(itemIndex, KeybindStore::NameColumn);
     case KeybindRole:
-        return item.keybind;
+        return m_store.text(itemIndex, KeybindStore::KeybindColumn);
     case DescriptionRole:
-        return item.description;
+        return m_store.text(itemIndex, KeybindStore::DescriptionColumn);
     case IconRole:
-        return item.icon;
+        return m_store.text(itemIndex, KeybindStore::IconColumn);
+    case DispatcherRole:
+        return m_store.text(itemIndex, KeybindStore::DispatcherColumn);
+    case MatchRangesRole: {
+        // Highlight ranges per field as [start, length, ...]
+        QVariantMap ranges;
+        if (!m_matchQuery.text.isEmpty()) {
+            ranges["name"] = matchRanges(itemIndex, FuzzyMatcher::NameField,
+                                         m_store.text(itemIndex, KeybindStore::NameColumn));
+            ranges["keybind"] = matchRanges(itemIndex, FuzzyMatcher::KeybindField,
+                                            m_store.text(itemIndex, KeybindStore::KeybindColumn));
+            ranges["description"] = matchRanges(itemIndex, FuzzyMatcher::DescriptionField,
+                                                m_store.text(itemIndex, KeybindStore::DescriptionColumn));
+        }
+        return ranges;
+    }
     default:
         return QVariant();
     }
@@ -58,9 +143,38 @@ QHash<int, QByteArray> KeybindModel::roleNames() const
     roles[KeybindRole] = "keybind";
     roles[DescriptionRole] = "description";
     roles[IconRole] = "icon";
+    roles[MatchRangesRole] = "matchRanges";
+    roles[DispatcherRole] = "dispatcher";
     return roles;
 }
 
+bool KeybindModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !m_continuousScroll)
+        return false;
+
+    return m_visibleRows.size() < m_filteredIndices.size();
+}
+
+// Append the next chunk of filtered rows
+void KeybindModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent))
+        return;
+
+    m_fetchLimit = int(m_visibleRows.size()) + FetchChunk;
+
+    // A queued sync rebuilds the rows from the filter anyway
+    if (m_syncPending)
+        return;
+
+    const int first = int(m_visibleRows.size());
+    const int last = qMin(m_fetchLimit, int(m_filteredIndices.size())) - 1;
+    beginInsertRows(QModelIndex(), first, last);
+    m_visibleRows.insert(m_visibleRows.end(), m_filteredIndices.cbegin() + first, m_filteredIndices.cbegin() + last + 1);
+    endInsertRows();
+}
+
 // Pagination getters and setters
 int KeybindModel::currentPage() const
 {
@@ -72,14 +186,16 @@ void KeybindModel::setCurrentPage(int page)
     if (m_currentPage != page) {
         m_currentPage = page;
         emit currentPageChanged();
-        emit totalPagesChanged();
-        refresh();
+        // In continuous-scroll mode the page only tracks the scroll position
+        if (!m_continuousScroll) {
+            scheduleSync();
+        }
     }
 }
 
 int KeybindModel::totalPages() const
 {
-    return (m_filteredKeybinds.size() + m_itemsPerPage - 1) / m_itemsPerPage;
+    return (int(m_filteredIndices.size()) + m_itemsPerPage - 1) / m_itemsPerPage;
 }
 
 int KeybindModel::itemsPerPage() const
@@ -89,11 +205,11 @@ int KeybindModel::itemsPerPage() const
 
 void KeybindModel::setItemsPerPage(int count)
 {
+    count = qMax(1, count);
     if (m_itemsPerPage != count) {
         m_itemsPerPage = count;
         emit itemsPerPageChanged();
-        emit totalPagesChanged();
-        refresh();
+        scheduleSync();
     }
 }
 
@@ -108,9 +224,159 @@ void KeybindModel::setFilterText(const QString &text)
     if (m_filterText != text) {
         m_filterText = text;
         emit filterTextChanged();
-        applyFilter();
-        setCurrentPage(0);
-        refresh();
+        clearChordFilter();
+        // Filtering runs once per event-loop turn, however many keystrokes arrived
+        m_filterDirty = true;
+        scheduleSync();
+    }
+}
+
+bool KeybindModel::fuzzyMatching() const
+{
+    return m_fuzzyMatching;
+}
+
+void KeybindModel::setFuzzyMatching(bool enabled)
+{
+    if (m_fuzzyMatching != enabled) {
+        m_fuzzyMatching = enabled;
+        emit fuzzyMatchingChanged();
+        m_filterDirty = true;
+        scheduleSync();
+    }
+}
+
+int KeybindModel::sortRole() const
+{
+    return m_sortRole;
+}
+
+void KeybindModel::setSortRole(int role)
+{
+    if (role != NameRole && role != KeybindRole && role != DescriptionRole && role != DispatcherRole) {
+        role = 0;
+    }
+    if (m_sortRole != role) {
+        m_sortRole = role;
+        emit sortChanged();
+        // Rows move into the new order on the next sync
+        m_filterDirty = true;
+        scheduleSync();
+    }
+}
+
+Qt::SortOrder KeybindModel::sortOrder() const
+{
+    return m_sortOrder;
+}
+
+void KeybindModel::setSortOrder(Qt::SortOrder order)
+{
+    if (m_sortOrder != order) {
+        m_sortOrder = order;
+        emit sortChanged();
+        if (m_sortRole != 0) {
+            m_filterDirty = true;
+            scheduleSync();
+        }
+    }
+}
+
+int KeybindModel::findChord(int key, int modifiers, int nativeScanCode)
+{
+    if (!m_filterText.isEmpty()) {
+        m_filterText.clear();
+        emit filterTextChanged();
+    }
+
+    // With Shift the event carries the shifted symbol, so SUPER SHIFT + 1
+    // arrives as Key_Exclam; binds name the key, which is tried first. Then
+    // the key as reported, for binds on the shifted keysym, and last the scan
+    // code, which is how "code:N" binds match.
+    QList<KeyChord> candidates;
+    if (modifiers & Qt::ShiftModifier) {
+        const int unshifted = KeyChord::unshiftedKey(key, quint32(qMax(nativeScanCode, 0)));
+        if (unshifted != key) {
+            candidates.append(KeyChord::fromKeyEvent(unshifted, modifiers));
+        }
+    }
+    candidates.append(KeyChord::fromKeyEvent(key, modifiers));
+    if (nativeScanCode > 0) {
+        candidates.append(KeyChord::fromScanCode(quint32(nativeScanCode), modifiers));
+    }
+
+    KeyChord chord = candidates.first();
+    const std::vector<quint32> *items = &m_indexes->chords.find(chord);
+    for (const KeyChord &candidate : candidates) {
+        const std::vector<quint32> &found = m_indexes->chords.find(candidate);
+        if (!found.empty()) {
+            chord = candidate;
+            items = &found;
+            break;
+        }
+    }
+
+    m_chordFilter = chord;
+    if (!items->empty()) {
+        m_chordFilterText = m_store.text(int(items->front()), KeybindStore::KeybindColumn);
+    } else {
+        // Shown as the unshifted chord that was looked up first
+        const int shownKey = int(chord.key);
+        const QString keyText = shownKey > 0x20 && shownKey < 0x7f ? QString(QChar(shownKey)) : QString::number(shownKey, 16);
+        m_chordFilterText = KeyChord::displayText(KeyChord::modifierNames(chord.modifiers), keyText);
+    }
+    emit chordFilterChanged();
+
+    m_filterDirty = true;
+    scheduleSync();
+    return int(items->size());
+}
+
+void KeybindModel::clearChordFilter()
+{
+    if (!m_chordFilter.isValid()) {
+        return;
+    }
+    m_chordFilter = KeyChord();
+    m_chordFilterText.clear();
+    emit chordFilterChanged();
+    m_filterDirty = true;
+    scheduleSync();
+}
+
+QString KeybindModel::chordFilter() const
+{
+    return m_chordFilterText;
+}
+
+int KeybindModel::chordConflicts() const
+{
+    return int(m_indexes->chords.conflicts().size());
+}
+
+QStringList KeybindModel::conflictDescriptions() const
+{
+    QStringList descriptions;
+    for (const ChordIndex::Conflict &conflict : m_indexes->chords.conflicts()) {
+        QStringList names;
+        for (quint32 item : conflict.items) {
+            names.append(m_store.text(int(item), KeybindStore::NameColumn));
+        }
+        descriptions.append(conflict.keybind + (conflict.duplicate ? " (duplicate): " : ": ") + names.join(", "));
+    }
+    return descriptions;
+}
+
+// Switch to the filter indexes of m_store and announce a changed conflict
+// count. They are built by the loader thread; swapping the pointer is all
+// the GUI thread does. A filter still running refers to the previous
+// indexes, so its result is dropped and the filter runs again.
+void KeybindModel::setIndexes(const KeybindFilter::IndexesPtr &indexes)
+{
+    const int previous = chordConflicts();
+    m_indexes = indexes;
+    if (chordConflicts() != previous) {
+        emit chordConflictsChanged();
     }
 }
 
@@ -132,277 +398,614 @@ void KeybindModel::setViewHeight(int height)
     }
 }
 
+bool KeybindModel::continuousScroll() const
+{
+    return m_continuousScroll;
+}
+
+void KeybindModel::setContinuousScroll(bool enabled)
+{
+    if (m_continuousScroll != enabled) {
+        m_continuousScroll = enabled;
+        // Keep the current page's rows materialized across the switch
+        m_fetchLimit = qMax(int(FetchChunk), (m_currentPage + 1) * m_itemsPerPage);
+        emit continuousScrollChanged();
+        scheduleSync();
+    }
+}
+
+int KeybindModel::jumpToSection(int section)
+{
+    // A pending or running filter would go back to the top once it lands,
+    // so it is applied here first and the jump is within its result
+    if (m_filterRunning || m_filterTimer.isActive()) {
+        m_filterDirty = true;
+    }
+    prepareSync();
+
+    section = qBound(0, section, qMax(0, totalPages() - 1));
+    if (m_currentPage != section) {
+        m_currentPage = section;
+        emit currentPageChanged();
+    }
+
+    // The view positions itself right after this returns, so the rows are
+    // applied now rather than on the next sync
+    const int start = section * m_itemsPerPage;
+    if (m_continuousScroll && m_fetchLimit < start + m_itemsPerPage) {
+        m_fetchLimit = start + m_itemsPerPage;
+    }
+    updateRows();
+    return m_continuousScroll ? qMin(start, qMax(0, rowCount() - 1)) : 0;
+}
+
 // Refresh the model (reset and emit signals)
 void KeybindModel::refresh()
 {
+    // A filter out on the filter thread is replaced by a synchronous one
+    if (m_filterRunning || m_filterTimer.isActive()) {
+        m_filterDirty = true;
+    }
+
     beginResetModel();
+    prepareSync();
+    m_visibleRows = pageRows();
+    m_rangesDirty = false;
     endResetModel();
-    emit totalPagesChanged();
+    updateTotalPages();
 }
 
-// Load keybinds from configuration file
-void KeybindModel::loadKeybinds()
+// Coalesce filter, page and size changes into one update per event-loop turn
+void KeybindModel::scheduleSync()
 {
-    beginResetModel();
-    m_keybinds.clear();
-    parseConfigFile();
-    applyFilter();
-    m_currentPage = 0;
-    endResetModel();
-    
-    emit totalPagesChanged();
-    emit currentPageChanged();
+    if (m_syncPending) {
+        return;
+    }
+    m_syncPending = true;
+    QMetaObject::invokeMethod(this, &KeybindModel::syncVisibleRows, Qt::QueuedConnection);
 }
 
-// Parse the configuration file
-void KeybindModel::parseConfigFile()
-{
-    // Clear existing data
-    m_keybinds.clear();
-    
-    // Map to store variables
-    QMap<QString, QString> variables;
-    
-    // Try to read the Hyprland config file first (updated paths based on user note)
-    QString hyprConfigPath = QDir::homePath() + "/.local/share/fredon/default/hypr/bindings.conf";
-    QString fallbackConfigPath = QDir::homePath() + "/.config/hypr/hyprland.conf";
-    QString localConfigPath = QDir(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)).filePath("bindings.conf");
-    
-    QString configPath = hyprConfigPath;
-    if (!QFile::exists(configPath)) {
-        configPath = localConfigPath;
-        if (!QFile::exists(configPath)) {
-            configPath = fallbackConfigPath;
-        }
+// Bring the visible rows in line with the filter and the current page
+void KeybindModel::syncVisibleRows()
+{
+    StartupTrace::Scope trace("syncVisibleRows");
+
+    // A changed filter runs on the filter thread and syncs the rows once its
+    // result arrives. While loading there are no indexes to search yet, so
+    // it runs here.
+    if (m_filterDirty && !m_loading) {
+        m_syncPending = false;
+        scheduleFilter();
+        return;
     }
-    
-    QFile file(configPath);
-    
-    // If none of the config files exist, try the default one
-    if (!file.exists()) {
-        configPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + 
-                    "/fredon-modal-cheat/default.conf";
-        file.setFileName(configPath);
-        
-        // If default config doesn't exist either, load sample data
-        if (!file.exists()) {
-            qWarning() << "Config file not found at any expected location. Loading sample data.";
-            loadSampleData();
-            return;
-        }
+
+    prepareSync();
+    updateRows();
+}
+
+// Apply pageRows() to the visible rows
+void KeybindModel::updateRows()
+{
+    const bool rangesDirty = m_rangesDirty;
+    m_rangesDirty = false;
+    applyRowDiff(pageRows());
+
+    // Rows that stayed visible may have matched differently
+    if (rangesDirty && !m_visibleRows.empty()) {
+        emit dataChanged(index(0), index(int(m_visibleRows.size()) - 1), { MatchRangesRole });
+    }
+
+    updateTotalPages();
+}
+
+// Run a pending filter and keep the page in range
+void KeybindModel::prepareSync()
+{
+    m_syncPending = false;
+
+    if (m_filterDirty) {
+        m_filterDirty = false;
+        applyFilter();
     }
 
-    qDebug() << "Loading config file:" << configPath;
-    if (!QFile::exists(configPath)) {
-        qWarning() << "Config file does not exist:" << configPath;
+    const int pages = totalPages();
+    if (m_currentPage > 0 && m_currentPage >= pages) {
+        m_currentPage = qMax(0, pages - 1);
+        emit currentPageChanged();
+    }
+}
+
+// Keybind indices that belong on the current page, or the materialized
+// prefix in continuous-scroll mode
+std::vector<quint32> KeybindModel::pageRows() const
+{
+    const int start = m_continuousScroll ? 0 : m_currentPage * m_itemsPerPage;
+    const int count = m_continuousScroll ? m_fetchLimit : m_itemsPerPage;
+    const int end = qMin(start + count, int(m_filteredIndices.size()));
+    std::vector<quint32> rows;
+    if (start < end) {
+        rows.assign(m_filteredIndices.cbegin() + start, m_filteredIndices.cbegin() + end);
     }
+    return rows;
+}
 
-    // Try to open the file
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Could not open config file:" << configPath << "Loading sample data.";
-        loadSampleData();
+void KeybindModel::updateTotalPages()
+{
+    const int pages = totalPages();
+    if (m_totalPages != pages) {
+        m_totalPages = pages;
+        emit totalPagesChanged();
+    }
+}
+
+// Turn m_visibleRows into target with minimal remove, move and insert signals
+void KeybindModel::applyRowDiff(const std::vector<quint32> &target)
+{
+    // Common when scrolling on in continuous mode: the rows are unchanged
+    // or only grow at the end
+    if (target.size() >= m_visibleRows.size()
+        && std::equal(m_visibleRows.cbegin(), m_visibleRows.cend(), target.cbegin())) {
+        if (target.size() > m_visibleRows.size()) {
+            beginInsertRows(QModelIndex(), int(m_visibleRows.size()), int(target.size()) - 1);
+            m_visibleRows.insert(m_visibleRows.end(), target.cbegin() + m_visibleRows.size(), target.cend());
+            endInsertRows();
+        }
         return;
     }
 
-    QTextStream in(&file);
-    QString lastIcon = "";
-    
-    // Parse the file line by line
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        
-        // Skip empty lines
-        if (line.isEmpty()) {
+    // Remove rows that are not wanted any more, bottom-up in contiguous runs
+    const QSet<quint32> wanted(target.cbegin(), target.cend());
+    for (int row = int(m_visibleRows.size()) - 1; row >= 0; --row) {
+        if (wanted.contains(m_visibleRows[row])) {
             continue;
         }
-        
-        // Handle variable definitions
-        if (line.startsWith("$")) {
-            int equalPos = line.indexOf('=');
-            if (equalPos != -1) {
-                QString varName = line.left(equalPos).trimmed();
-                QString varValue = line.mid(equalPos + 1).trimmed();
-                variables[varName] = varValue;
-                qDebug() << "Found variable:" << varName << "=" << varValue;
-            }
-            continue;
+        const int last = row;
+        while (row > 0 && !wanted.contains(m_visibleRows[row - 1])) {
+            --row;
         }
-        
-        // Handle icon comments
-        if (line.startsWith("## ICON:")) {
-            lastIcon = line.mid(8).trimmed(); // Remove "## ICON:" prefix
-            qDebug() << "Found icon:" << lastIcon;
+        beginRemoveRows(QModelIndex(), row, last);
+        m_visibleRows.erase(m_visibleRows.begin() + row, m_visibleRows.begin() + last + 1);
+        endRemoveRows();
+    }
+
+    // The remaining rows are a subset of target; move and insert into place
+    const QSet<quint32> present(m_visibleRows.cbegin(), m_visibleRows.cend());
+    for (int row = 0; row < int(target.size()); ++row) {
+        const quint32 id = target[row];
+        if (row < int(m_visibleRows.size()) && m_visibleRows[row] == id) {
             continue;
         }
-        
-        // Handle bind commands
-        if (line.startsWith("bind") || line.startsWith("bindm") || line.startsWith("bindi") || line.startsWith("bindel") || line.startsWith("bindl")) {
-            qDebug() << "Processing binding:" << line;
-            
-            // Parse the binding
-            KeybindItem item;
-            
-            // Extract command type (bind, bindm, etc.)
-            int equalPos = line.indexOf('=');
-            if (equalPos == -1) continue;
-            
-            QString commandType = line.left(equalPos).trimmed();
-            QString bindingData = line.mid(equalPos + 1).trimmed();
-            
-            // Split the binding data by commas
-            QStringList parts = bindingData.split(',');
-            if (parts.size() < 3) continue;
-            
-            // Extract modifiers and key
-            QString modifiers = parts[0].trimmed();
-            QString key = parts[1].trimmed();
-            
-            // Resolve variables in modifiers
-            for (auto it = variables.constBegin(); it != variables.constEnd(); ++it) {
-                modifiers.replace(it.key(), it.value());
-            }
-            
-            // Format the keybind display
-            item.keybind = modifiers;
-            if (!item.keybind.isEmpty() && !key.isEmpty()) {
-                item.keybind += " + ";
-            }
-            item.keybind += key;
-            
-            // Extract dispatcher and parameters
-            QString dispatcher = parts[2].trimmed();
-            QString params = "";
-            if (parts.size() > 3) {
-                params = parts.mid(3).join(',').trimmed();
-            }
-            
-            // Set name and description based on dispatcher and params
-            if (dispatcher == "exec" && !params.isEmpty()) {
-                // For exec commands, try to extract a meaningful name
-                QString command = params;
-                
-                // Remove common prefixes
-                if (command.startsWith("\"")) command = command.mid(1);
-                if (command.endsWith("\"")) command = command.left(command.length() - 1);
-                
-                // Extract command name from path
-                QStringList commandParts = command.split(' ');
-                QString executable = commandParts.first();
-                QFileInfo fileInfo(executable);
-                QString commandName = fileInfo.baseName();
-                
-                // Special handling for some common commands
-                if (commandName == "kitty") {
-                    item.name = "Terminal";
-                } else if (commandName == "hyprshot") {
-                    item.name = "Screenshot";
-                } else if (commandName == "hyprpicker") {
-                    item.name = "Color Picker";
-                } else if (commandName == "code") {
-                    item.name = "Code Editor";
-                } else if (commandName == "walker") {
-                    item.name = "Application Launcher";
-                } else if (commandName == "waypaper") {
-                    item.name = "Wallpaper Changer";
-                } else if (commandName == "wlogout") {
-                    item.name = "Power Menu";
-                } else if (commandName == "swaync-client") {
-                    item.name = "Notifications";
-                } else if (commandName == "btop") {
-                    item.name = "System Monitor";
-                } else if (commandName == "lazydocker") {
-                    item.name = "Docker Manager";
-                } else if (commandName == "clipse") {
-                    item.name = "Clipboard Manager";
-                } else {
-                    // Capitalize first letter
-                    commandName[0] = commandName[0].toUpper();
-                    item.name = commandName;
-                }
-                
-                item.description = "Execute: " + command;
-            } else {
-                // For other dispatchers, use the dispatcher name as the name
-                item.name = dispatcher;
-                // Capitalize first letter
-                if (!item.name.isEmpty()) {
-                    item.name[0] = item.name[0].toUpper();
-                }
-                
-                // Create description from dispatcher and params
-                item.description = dispatcher;
-                if (!params.isEmpty()) {
-                    item.description += " " + params;
-                }
+
+        if (present.contains(id)) {
+            const int from = int(std::find(m_visibleRows.begin() + row, m_visibleRows.end(), id) - m_visibleRows.begin());
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), row);
+            m_visibleRows.erase(m_visibleRows.begin() + from);
+            m_visibleRows.insert(m_visibleRows.begin() + row, id);
+            endMoveRows();
+        } else {
+            // Insert a run of new rows at once
+            int end = row + 1;
+            while (end < int(target.size()) && !present.contains(target[end])) {
+                ++end;
             }
-            
-            // Set icon if available
-            item.icon = lastIcon;
-            
-            // Add to list
-            m_keybinds.append(item);
-            qDebug() << "Added keybind:" << item.name << "-" << item.keybind;
-            
-            // Reset lastIcon for next binding
-            lastIcon = "";
+            beginInsertRows(QModelIndex(), row, end - 1);
+            m_visibleRows.insert(m_visibleRows.begin() + row, target.cbegin() + row, target.cbegin() + end);
+            endInsertRows();
+            row = end - 1;
         }
     }
+}
 
-    file.close();
-    
-    qDebug() << "Loaded" << m_keybinds.size() << "keybinds";
+void KeybindModel::setConfigPath(const QString &path)
+{
+    // Queued ahead of any later load request
+    QMetaObject::invokeMethod(m_loader, "setConfigPath", Qt::QueuedConnection, Q_ARG(QString, path));
 }
 
-// Apply filter to the keybind list
-void KeybindModel::applyFilter()
+void KeybindModel::setIpcSocketPath(const QString &path)
 {
-    m_filteredKeybinds.clear();
-    
-    // If no filter text, show all items
-    if (m_filterText.isEmpty()) {
-        m_filteredKeybinds = m_keybinds;
-    } 
-    else {
-        // Filter items based on name, keybind, or description
-        for (const KeybindItem &item : m_keybinds) {
-            if (item.name.contains(m_filterText, Qt::CaseInsensitive) ||
-                item.keybind.contains(m_filterText, Qt::CaseInsensitive) ||
-                item.description.contains(m_filterText, Qt::CaseInsensitive)) {
-                m_filteredKeybinds.append(item);
-            }
+    QMetaObject::invokeMethod(m_loader, "setIpcSocketPath", Qt::QueuedConnection, Q_ARG(QString, path));
+}
+
+// Replace the keybinds in one step; the filter and search structures are rebuilt now
+// unless they come with the items
+void KeybindModel::setKeybinds(const QList<KeybindItem> &items, const KeybindFilter::IndexesPtr &indexes)
+{
+    // Batches of a load still in flight are stale from here on
+    ++m_loadGeneration;
+
+    beginResetModel();
+    m_store.clear();
+    m_store.append(items);
+    if (indexes) {
+        setIndexes(indexes);
+    } else {
+        auto built = std::make_shared<KeybindFilter::Indexes>();
+        built->build(m_store);
+        setIndexes(built);
+    }
+    m_filterDirty = false;
+    applyFilter();
+    resetScrollPosition();
+    m_visibleRows = pageRows();
+    m_rangesDirty = false;
+    endResetModel();
+    updateTotalPages();
+
+    if (m_loading) {
+        m_loading = false;
+        emit loadingChanged();
+    }
+    emit loaded();
+}
+
+int KeybindModel::filteredCount() const
+{
+    return int(m_filteredIndices.size());
+}
+
+KeybindItem KeybindModel::filteredKeybind(int position) const
+{
+    return m_store.item(int(m_filteredIndices[size_t(position)]));
+}
+
+// Load keybinds from configuration file
+void KeybindModel::loadKeybinds()
+{
+    // Start from an empty model; a newer load makes older batches stale
+    beginResetModel();
+    m_store.clear();
+    m_visibleRows.clear();
+    m_filteredIndices.clear();
+    const bool hadConflicts = chordConflicts() > 0;
+    m_indexes = std::make_shared<KeybindFilter::Indexes>();
+    m_currentPage = 0;
+    m_totalPages = 0;
+    m_fetchLimit = FetchChunk;
+    endResetModel();
+
+    ++m_loadGeneration;
+    if (!m_loading) {
+        m_loading = true;
+        emit loadingChanged();
+    }
+    emit totalPagesChanged();
+    emit currentPageChanged();
+    if (hadConflicts) {
+        emit chordConflictsChanged();
+    }
+
+    startLoaderThread();
+    QMetaObject::invokeMethod(m_loader, "load", Qt::QueuedConnection, Q_ARG(quint64, m_loadGeneration));
+}
+
+// Re-parse after a change on disk; the current rows stay until the result arrives
+void KeybindModel::reloadKeybinds(const QStringList &changedPaths)
+{
+    // A load still streaming in has to start over to see the change
+    if (m_loading) {
+        loadKeybinds();
+        return;
+    }
+
+    ++m_loadGeneration;
+    startLoaderThread();
+    QMetaObject::invokeMethod(m_loader, "reload", Qt::QueuedConnection,
+                              Q_ARG(quint64, m_loadGeneration), Q_ARG(QStringList, changedPaths));
+}
+
+// Add a batch of keybinds delivered by the loader thread
+void KeybindModel::appendBatch(quint64 generation, const QList<KeybindItem> &items)
+{
+    if (generation != m_loadGeneration) {
+        return;
+    }
+
+    const int first = m_store.size();
+    m_store.append(items);
+
+    // Ranked and sorted results need the full list; they are filtered once loading finishes
+    if (!m_filterText.isEmpty() || m_chordFilter.isValid() || m_sortRole != 0) {
+        return;
+    }
+
+    // Unfiltered rows go to the end; the next sync inserts whatever lands on this page
+    for (int i = first; i < m_store.size(); ++i) {
+        m_filteredIndices.push_back(quint32(i));
+    }
+    scheduleSync();
+}
+
+// Take over the search structures once every batch has arrived
+void KeybindModel::finishLoading(quint64 generation, bool cacheHit, const QStringList &sourceFiles,
+                                 const KeybindFilter::IndexesPtr &indexes)
+{
+    if (generation != m_loadGeneration) {
+        return;
+    }
+
+    if (cacheHit) {
+        ++m_cacheHits;
+    } else {
+        ++m_cacheMisses;
+    }
+    emit cacheStatsChanged();
+
+    // Built by the loader from the same items, in the order of the batches
+    setIndexes(indexes);
+
+    if (m_filterDirty || !m_filterText.isEmpty() || m_chordFilter.isValid() || m_sortRole != 0) {
+        m_filterDirty = true;
+        scheduleSync();
+    }
+
+    m_loading = false;
+    emit loadingChanged();
+    emit loaded();
+    setSourceFiles(sourceFiles);
+    qDebug() << "Keybinds loaded:" << m_store.size() << "using" << m_store.memoryUsage() << "bytes";
+}
+
+// Replace the keybinds with a reloaded list, touching only rows that changed
+void KeybindModel::mergeKeybinds(quint64 generation, const QList<KeybindItem> &items, const QStringList &sourceFiles,
+                                 const KeybindFilter::IndexesPtr &indexes)
+{
+    if (generation != m_loadGeneration) {
+        return;
+    }
+
+    KeybindStore store;
+    store.append(items);
+
+    // Match old items to new ones by content; duplicates pair up in order
+    auto contentKey = [](const KeybindStore &s, int i) {
+        return s.text(i, KeybindStore::NameColumn) + QChar(0x1f)
+             + s.text(i, KeybindStore::KeybindColumn) + QChar(0x1f)
+             + s.text(i, KeybindStore::DescriptionColumn) + QChar(0x1f)
+             + s.text(i, KeybindStore::IconColumn) + QChar(0x1f)
+             + s.text(i, KeybindStore::DispatcherColumn);
+    };
+    QHash<QString, QList<quint32>> newIndices;
+    for (int i = store.size() - 1; i >= 0; --i) {
+        newIndices[contentKey(store, i)].append(quint32(i));
+    }
+
+    // Unchanged rows keep their identity under the new index, so the diff
+    // below leaves them in place; rows that went away get ids no item has
+    quint32 removedId = 0xffffffff;
+    for (quint32 &row : m_visibleRows) {
+        auto it = newIndices.find(contentKey(m_store, int(row)));
+        if (it != newIndices.end() && !it->isEmpty()) {
+            row = it->takeLast();
+        } else {
+            row = removedId--;
         }
     }
-    
+
+    m_store = std::move(store);
+    setIndexes(indexes);
+
+    // Keep the page the user is on; prepareSync() clamps it if it shrank.
+    // A debounced or running filter would sync later and from page 0, so it
+    // is replaced by this synchronous one, and the rows are synced right away
+    // so none of the ids of removed items above stays visible.
+    cancelFilter();
+    m_filterDirty = false;
+    runFilter();
+    prepareSync();
+    updateRows();
+
+    setSourceFiles(sourceFiles);
+    qDebug() << "Keybinds reloaded:" << m_store.size() << "keybinds";
+}
+
+QStringList KeybindModel::sourceFiles() const
+{
+    return m_sourceFiles;
+}
+
+void KeybindModel::setSourceFiles(const QStringList &files)
+{
+    if (m_sourceFiles != files) {
+        m_sourceFiles = files;
+        emit sourceFilesChanged(m_sourceFiles);
+    }
+}
+
+// Binary cache counters
+int KeybindModel::cacheHits() const
+{
+    return m_cacheHits;
+}
+
+int KeybindModel::cacheMisses() const
+{
+    return m_cacheMisses;
+}
+
+bool KeybindModel::loading() const
+{
+    return m_loading;
+}
+
+// Heap usage per part; the filter thread's narrowing copy is not included
+KeybindModel::MemoryUsage KeybindModel::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.strings = m_store.stringBytes();
+    usage.columns = m_store.columnBytes();
+    usage.filtered = qint64(m_filteredIndices.capacity()) * qint64(sizeof(quint32)) + m_filter.memoryUsage();
+    usage.visibleRows = qint64(m_visibleRows.capacity()) * qint64(sizeof(quint32));
+    usage.searchIndex = m_indexes->search.memoryUsage();
+    usage.fuzzyMatcher = m_indexes->fuzzy.memoryUsage();
+    usage.chordIndex = m_indexes->chords.memoryUsage();
+    usage.sortIndex = m_indexes->sort.memoryUsage();
+    return usage;
+}
+
+bool KeybindModel::filtering() const
+{
+    return m_filterRunning;
+}
+
+void KeybindModel::setFilterRunning(bool running)
+{
+    if (m_filterRunning != running) {
+        m_filterRunning = running;
+        emit filteringChanged();
+    }
+}
+
+// Apply filter to the keybind list; a new query goes back to the first page
+void KeybindModel::applyFilter()
+{
+    StartupTrace::Scope trace("applyFilter");
+    cancelFilter();
+    runFilter();
+}
+
+// A new query starts from the top with only the first chunk materialized
+void KeybindModel::resetScrollPosition()
+{
+    m_fetchLimit = FetchChunk;
+
     // Reset to first page when filter changes
-    m_currentPage = 0;
+    if (m_currentPage != 0) {
+        m_currentPage = 0;
+        emit currentPageChanged();
+    }
 }
 
-// Load sample data when config file is not available
-void KeybindModel::loadSampleData()
-{
-    m_keybinds.clear();
-    
-    // Add sample keybinds in Hyprland format
-    m_keybinds.append({"Terminal", "SUPER + Return", "Execute: kitty", ""});
-    m_keybinds.append({"File Manager", "SUPER + E", "Execute: thunar", ""});
-    m_keybinds.append({"Browser", "SUPER + W", "Execute: firefox", ""});
-    m_keybinds.append({"Code Editor", "SUPER + C", "Execute: code", ""});
-    m_keybinds.append({"Application Launcher", "SUPER + A", "Execute: walker", ""});
-    m_keybinds.append({"Screenshot", "SUPER + S", "Execute: hyprshot -m output", ""});
-    m_keybinds.append({"Color Picker", "SUPER + P", "Execute: hyprpicker -a", ""});
-    m_keybinds.append({"System Monitor", "SUPER + T", "Execute: kitty -e btop", ""});
-    m_keybinds.append({"Kill Active Window", "SUPER + Q", "Kill active window", ""});
-    m_keybinds.append({"Toggle Floating", "SUPER + H", "Toggle floating mode", ""});
-    m_keybinds.append({"Workspace 1", "SUPER + 1", "Switch to workspace 1", ""});
-    m_keybinds.append({"Workspace 2", "SUPER + 2", "Switch to workspace 2", ""});
-    m_keybinds.append({"Move to Workspace 1", "SUPER + SHIFT + 1", "Move window to workspace 1", ""});
-    m_keybinds.append({"Resize Width +", "SUPER + =", "Resize active window", ""});
-    m_keybinds.append({"Next Workspace", "SUPER + Mouse Wheel Up", "Switch to next workspace", ""});
-    m_keybinds.append({"Previous Workspace", "SUPER + Mouse Wheel Down", "Switch to previous workspace", ""});
-    m_keybinds.append({"Move Window", "SUPER + LMB", "Move window with mouse", ""});
-    m_keybinds.append({"Resize Window", "SUPER + RMB", "Resize window with mouse", ""});
-    m_keybinds.append({"Volume Up", "XF86AudioRaiseVolume", "Increase volume", ""});
-    m_keybinds.append({"Volume Down", "XF86AudioLowerVolume", "Decrease volume", ""});
-    
-    m_filteredKeybinds = m_keybinds;
+// Recompute m_filteredIndices for the current filter on this thread
+void KeybindModel::runFilter()
+{
+    KeybindFilter::Result result;
+    m_filter.run(m_indexes, filterRequest(), CancelToken(), &result);
+    adoptFilterResult(&result);
+}
+
+// Run the filter now, or once typing pauses if the last one overran a frame
+void KeybindModel::scheduleFilter()
+{
+    const qint64 lastMs = m_lastFilterNs / 1000000;
+    if (lastMs > FrameBudgetMs) {
+        // Restarted by every keystroke that arrives in the meantime
+        m_filterTimer.start(int(qMin<qint64>(lastMs, MaxFilterDebounceMs)));
+    } else {
+        startFilter();
+    }
+}
+
+// Hand the current filter to the filter thread under a new generation;
+// older requests still queued or running there are cancelled
+void KeybindModel::startFilter()
+{
+    m_filterTimer.stop();
+    m_filterDirty = false;
+    setFilterRunning(true);
+    m_filterWorker->supersede(++m_filterGeneration);
+
+    if (!m_filterThread.isRunning()) {
+        m_filterThread.start();
+    }
+    QMetaObject::invokeMethod(m_filterWorker, "filter", Qt::QueuedConnection,
+                              Q_ARG(quint64, m_filterGeneration),
+                              Q_ARG(KeybindFilter::IndexesPtr, m_indexes),
+                              Q_ARG(KeybindFilter::Request, filterRequest()));
+}
+
+// Drop a debounced or running filter; the caller filters synchronously instead
+void KeybindModel::cancelFilter()
+{
+    m_filterTimer.stop();
+    if (m_filterRunning) {
+        m_filterWorker->supersede(++m_filterGeneration);
+        setFilterRunning(false);
+    }
+}
+
+// Apply the newest result from the filter thread in one step
+void KeybindModel::applyFilterResult(const KeybindFilter::ResultPtr &result)
+{
+    // Superseded by a newer request or a synchronous filter
+    if (result->generation != m_filterGeneration) {
+        return;
+    }
+    setFilterRunning(false);
+
+    // The keybinds were replaced while it ran; filter them instead
+    if (result->indexes != m_indexes) {
+        m_filterDirty = true;
+        scheduleSync();
+        return;
+    }
+
+    StartupTrace::Scope trace("applyFilterResult");
+    adoptFilterResult(result.get());
+    updateRows();
+}
+
+// Take over the indices and match state of a finished filter run. A new
+// query starts from the top; a new sort order of the same rows keeps the
+// page and the materialized rows, so the rows move into place.
+void KeybindModel::adoptFilterResult(KeybindFilter::Result *result)
+{
+    m_filteredIndices.swap(result->indices);
+    m_matchQuery = result->query;
+    m_matchFuzzy = result->fuzzy;
+    m_shownRequest = result->request;
+    m_lastFilterNs = result->elapsedNs;
+    m_rangesDirty = true;
+    if (!result->request.keepPosition) {
+        resetScrollPosition();
+    }
+}
+
+// Snapshot of the filter settings for one run
+KeybindFilter::Request KeybindModel::filterRequest() const
+{
+    KeybindFilter::Request request;
+    request.itemCount = m_store.size();
+    request.text = m_filterText;
+    request.fuzzy = m_fuzzyMatching;
+    request.chord = m_chordFilter;
+    request.descending = m_sortOrder == Qt::DescendingOrder;
+    request.keepPosition = request.text == m_shownRequest.text && request.fuzzy == m_shownRequest.fuzzy
+                        && request.chord == m_shownRequest.chord;
+
+    switch (m_sortRole) {
+    case NameRole:
+        request.sortKey = KeybindSortIndex::NameKey;
+        break;
+    case KeybindRole:
+        request.sortKey = KeybindSortIndex::KeybindKey;
+        break;
+    case DescriptionRole:
+        request.sortKey = KeybindSortIndex::DescriptionKey;
+        break;
+    case DispatcherRole:
+        request.sortKey = KeybindSortIndex::DispatcherKey;
+        break;
+    default:
+        break;
+    }
+    return request;
+}
+
+// Character ranges of a field that matched the current filter
+QVariantList KeybindModel::matchRanges(int item, FuzzyMatcher::Field field, const QString &text) const
+{
+    QVariantList ranges;
+    if (m_matchFuzzy) {
+        const QList<int> positions = m_indexes->fuzzy.matchRanges(m_matchQuery, item, field);
+        for (int value : positions) {
+            ranges.append(value);
+        }
+    } else {
+        int start = text.indexOf(m_matchQuery.text, 0, Qt::CaseInsensitive);
+        if (start >= 0) {
+            ranges << start << m_matchQuery.text.size();
+        }
+    }
+    return ranges;
 }
@@ -2,32 +2,45 @@
 #define KEYBINDMODEL_H
 
 #include <QAbstractListModel>
+#include <QtQml/qqml.h>
 #include <QList>
 #include <QString>
+#include <QStringList>
 #include <QStandardPaths>
 #include <QFile>
 #include <QTextStream>
 #include <QDebug>
 #include <QMap>
 #include <QFileInfo>
+#include "KeybindItem.h"
+#include <QThread>
+#include <QTimer>
+#include <vector>
+#include "KeybindStore.h"
+#include "KeybindFilter.h"
 
-// Structure to hold keybind data
-struct KeybindItem {
-    QString name;
-    QString keybind;
-    QString description;
-    QString icon;
-};
+class KeybindLoader;
 
 // Model class for keybind data
 class KeybindModel : public QAbstractListModel
 {
     Q_OBJECT
+    QML_ELEMENT
     Q_PROPERTY(int currentPage READ currentPage WRITE setCurrentPage NOTIFY currentPageChanged)
     Q_PROPERTY(int totalPages READ totalPages NOTIFY totalPagesChanged)
     Q_PROPERTY(int itemsPerPage READ itemsPerPage WRITE setItemsPerPage NOTIFY itemsPerPageChanged)
     Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged)
+    Q_PROPERTY(bool fuzzyMatching READ fuzzyMatching WRITE setFuzzyMatching NOTIFY fuzzyMatchingChanged)
     Q_PROPERTY(int viewHeight READ viewHeight WRITE setViewHeight NOTIFY viewHeightChanged)
+    Q_PROPERTY(int cacheHits READ cacheHits NOTIFY cacheStatsChanged)
+    Q_PROPERTY(int cacheMisses READ cacheMisses NOTIFY cacheStatsChanged)
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
+    Q_PROPERTY(bool filtering READ filtering NOTIFY filteringChanged)
+    Q_PROPERTY(QString chordFilter READ chordFilter NOTIFY chordFilterChanged)
+    Q_PROPERTY(int chordConflicts READ chordConflicts NOTIFY chordConflictsChanged)
+    Q_PROPERTY(int sortRole READ sortRole WRITE setSortRole NOTIFY sortChanged)
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortChanged)
+    Q_PROPERTY(bool continuousScroll READ continuousScroll WRITE setContinuousScroll NOTIFY continuousScrollChanged)
 
 public:
     // Define roles for the model
@@ -35,17 +48,46 @@ public:
         NameRole = Qt::UserRole + 1,
         KeybindRole,
         DescriptionRole,
-        IconRole
+        IconRole,
+        MatchRangesRole,
+        DispatcherRole
+    };
+    Q_ENUM(Roles)
+
+    // Approximate heap usage of each part of the model, in bytes
+    struct MemoryUsage {
+        qint64 strings = 0;         // Interned strings and their lookup hash
+        qint64 columns = 0;         // String ids per item and column
+        qint64 filtered = 0;        // Filtered indices and the narrowing copy
+        qint64 visibleRows = 0;
+        qint64 searchIndex = 0;
+        qint64 fuzzyMatcher = 0;
+        qint64 chordIndex = 0;
+        qint64 sortIndex = 0;
     };
 
+    // Rows materialized per fetchMore() in continuous-scroll mode
+    static const int FetchChunk = 100;
+
+    // Filters that took longer than a frame are debounced by about as long
+    // as they took, up to MaxFilterDebounceMs
+    static const int FrameBudgetMs = 16;
+    static const int MaxFilterDebounceMs = 120;
+
     // Constructor
     explicit KeybindModel(QObject *parent = nullptr);
+    ~KeybindModel() override;
 
     // Required methods for QAbstractListModel
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
 
+    // Continuous-scroll mode: rows are materialized in chunks as the view
+    // nears the end
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
     // Pagination properties
     int currentPage() const;
     void setCurrentPage(int page);
@@ -59,33 +101,166 @@ public:
     QString filterText() const;
     void setFilterText(const QString &text);
 
+    bool fuzzyMatching() const;
+    void setFuzzyMatching(bool enabled);
+
+    // Order of the filtered rows: 0 keeps file order (or fuzzy rank while
+    // searching); NameRole, KeybindRole, DescriptionRole and DispatcherRole
+    // sort by that field. Ties keep their previous order.
+    int sortRole() const;
+    void setSortRole(int role);
+    Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder order);
+
+    // Show only the keybinds bound to a pressed combination, given as a QML
+    // key event's key, modifiers and nativeScanCode; returns the match count.
+    // Any change to filterText clears it again.
+    Q_INVOKABLE int findChord(int key, int modifiers, int nativeScanCode = 0);
+    Q_INVOKABLE void clearChordFilter();
+    QString chordFilter() const;
+
+    // Chords bound more than once in the same submap, found at load time
+    int chordConflicts() const;
+    Q_INVOKABLE QStringList conflictDescriptions() const;
+
     int viewHeight() const;
     void setViewHeight(int height);
 
+    // One growing list instead of pages; pages then only name sections
+    // of itemsPerPage rows to jump to
+    bool continuousScroll() const;
+    void setContinuousScroll(bool enabled);
+
+    // Make the given page current and return the row it starts at. In
+    // continuous-scroll mode the rows up to the end of that section are
+    // materialized first, so the view can be positioned at the returned row.
+    Q_INVOKABLE int jumpToSection(int section);
+
+    // Binary cache counters
+    int cacheHits() const;
+    int cacheMisses() const;
+
+    // True while the loader thread is still delivering keybinds
+    bool loading() const;
+
+    MemoryUsage memoryUsage() const;
+
+    // True while a filter runs on the filter thread; the rows still show
+    // the previous result until it is done
+    bool filtering() const;
+
     // Public methods
+    // Read this config file instead of searching the default locations
+    void setConfigPath(const QString &path);
+
+    // Ask this Hyprland socket for binds; empty to parse config files only
+    void setIpcSocketPath(const QString &path);
+
+    // Starts loading on the loader thread; rows are inserted as batches arrive
     Q_INVOKABLE void loadKeybinds();
+
+    // Replace the keybinds synchronously, without the loader thread or a
+    // config file (tools and benchmarks). Indexes the loader already built
+    // for items are used as they are; without them they are built here.
+    void setKeybinds(const QList<KeybindItem> &items,
+                     const KeybindFilter::IndexesPtr &indexes = KeybindFilter::IndexesPtr());
+
+    // Every keybind that passes the filter, in display order (not just the
+    // current page); valid after the filter has been applied
+    int filteredCount() const;
+    KeybindItem filteredKeybind(int position) const;
+    // Re-parses only the changed files and merges the result into the rows
+    Q_INVOKABLE void reloadKeybinds(const QStringList &changedPaths);
     Q_INVOKABLE void refresh();
 
+    // Files the current keybinds were read from, plus globbed directories
+    QStringList sourceFiles() const;
+
 signals:
     void currentPageChanged();
     void totalPagesChanged();
     void itemsPerPageChanged();
     void filterTextChanged();
+    void fuzzyMatchingChanged();
+    void chordFilterChanged();
+    void sortChanged();
+    void chordConflictsChanged();
     void viewHeightChanged();
+    void continuousScrollChanged();
+    void cacheStatsChanged();
+    void loadingChanged();
+    void filteringChanged();
+    void loaded();
+    void sourceFilesChanged(const QStringList &files);
+
+private slots:
+    void appendBatch(quint64 generation, const QList<KeybindItem> &items);
+    void finishLoading(quint64 generation, bool cacheHit, const QStringList &sourceFiles,
+                       const KeybindFilter::IndexesPtr &indexes);
+    void mergeKeybinds(quint64 generation, const QList<KeybindItem> &items, const QStringList &sourceFiles,
+                       const KeybindFilter::IndexesPtr &indexes);
+    void applyFilterResult(const KeybindFilter::ResultPtr &result);
+    void startFilter();
 
 private:
     // Internal data storage
-    QList<KeybindItem> m_keybinds;          // All keybinds
-    QList<KeybindItem> m_filteredKeybinds;  // Filtered keybinds
+    KeybindStore m_store;                   // All keybinds, interned column-wise
+    std::vector<quint32> m_visibleRows;     // Keybind indices shown as rows
     int m_currentPage;                      // Current page index
     int m_itemsPerPage;                     // Items per page
     QString m_filterText;                   // Current filter text
+    KeybindFilter::IndexesPtr m_indexes;    // Search, fuzzy, chord and sort indexes of m_store
+    KeybindFilter m_filter;                 // Runs synchronous filters
+    std::vector<quint32> m_filteredIndices; // Indices of the filtered keybinds, in display order
+    FuzzyMatcher::Query m_matchQuery;       // Query that produced m_filteredIndices
+    bool m_matchFuzzy;                      // Whether that query was ranked fuzzily
+    KeybindFilter::Request m_shownRequest;  // Settings m_filteredIndices were made with
+    bool m_fuzzyMatching;                   // Rank by fuzzy score instead of substring
+    int m_sortRole;                         // Role to sort by, 0 for none
+    Qt::SortOrder m_sortOrder;              // Direction of that sort
+    KeyChord m_chordFilter;                 // Pressed chord being shown, if any
+    QString m_chordFilterText;              // How that chord is displayed
     int m_viewHeight;                   // Height of the view in pixels
+    bool m_continuousScroll;                // Materialize a growing prefix instead of a page
+    int m_fetchLimit;                       // Rows to materialize in continuous-scroll mode
+    int m_totalPages;                       // Last page count announced
+    bool m_syncPending;                     // syncVisibleRows() is queued
+    bool m_filterDirty;                     // Filter must be re-run on sync
+    bool m_rangesDirty;                     // Match ranges of visible rows changed
+    QThread m_filterThread;                 // Thread filters run on while typing
+    KeybindFilterWorker *m_filterWorker;    // Filters off the GUI thread
+    quint64 m_filterGeneration;             // Identifies the newest filter request
+    bool m_filterRunning;                   // A request is out on the filter thread
+    qint64 m_lastFilterNs;                  // Duration of the last completed filter
+    QTimer m_filterTimer;                   // Debounces slow filters
+    QThread m_loaderThread;                 // Thread the loader runs on
+    KeybindLoader *m_loader;                // Parses off the GUI thread
+    quint64 m_loadGeneration;               // Identifies the current load
+    bool m_loading;                         // Load in progress
+    int m_cacheHits;                        // Loads served from the cache
+    int m_cacheMisses;                      // Loads that had to parse
+    QStringList m_sourceFiles;              // Inputs of the current keybinds
 
     // Private methods
-    void parseConfigFile();
+    void startLoaderThread();
+    void scheduleSync();
+    void syncVisibleRows();
+    void prepareSync();
+    void updateRows();
+    std::vector<quint32> pageRows() const;
+    void updateTotalPages();
+    void applyRowDiff(const std::vector<quint32> &target);
     void applyFilter();
-    void loadSampleData();
+    void runFilter();
+    void scheduleFilter();
+    void cancelFilter();
+    void setFilterRunning(bool running);
+    void adoptFilterResult(KeybindFilter::Result *result);
+    void resetScrollPosition();
+    KeybindFilter::Request filterRequest() const;
+    void setSourceFiles(const QStringList &files);
+    void setIndexes(const KeybindFilter::IndexesPtr &indexes);
+    QVariantList matchRanges(int item, FuzzyMatcher::Field field, const QString &text) const;
 };
 
 #endif // KEYBINDMODEL_H
\ No newline at end of file
@@ -0,0 +1,583 @@
+#include "KeybindParser.h"
+#include "ChordIndex.h"
+#include "DesktopEntryIndex.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QRegularExpression>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QDebug>
+#include <cstring>
+#include <vector>
+
+// Find the configuration file to read, or an empty string if there is none
+QString KeybindParser::findConfigFile()
+{
+    // Try to read the Hyprland config file first (updated paths based on user note)
+    QString hyprConfigPath = QDir::homePath() + "/.local/share/fredon/default/hypr/bindings.conf";
+    QString fallbackConfigPath = QDir::homePath() + "/.config/hypr/hyprland.conf";
+    QString localConfigPath = QDir(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)).filePath("bindings.conf");
+    QString defaultConfigPath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + 
+                                "/fredon-modal-cheat/default.conf";
+    
+    for (const QString &configPath : { hyprConfigPath, localConfigPath, fallbackConfigPath, defaultConfigPath }) {
+        if (QFile::exists(configPath)) {
+            return configPath;
+        }
+    }
+    return QString();
+}
+
+// Parse the configuration file and everything it sources, passing each
+// keybind to handler in load order
+bool KeybindParser::parseFile(const QString &configPath, const ItemHandler &handler)
+{
+    m_files.clear();
+
+    qDebug() << "Loading config file:" << configPath;
+
+    m_rootPath = QFileInfo(configPath).canonicalFilePath();
+    if (m_rootPath.isEmpty()) {
+        m_rootPath = configPath;
+    }
+
+    return load({ m_rootPath }, handler);
+}
+
+// Parse config text from an open device. Its sources are followed relative
+// to the working directory; there is nothing to re-read on reparseFiles().
+bool KeybindParser::parseDevice(QIODevice *device, const ItemHandler &handler)
+{
+    m_files.clear();
+    m_rootPath = QStringLiteral("<device>");
+
+    ParsedConfigFile root = tokenizeDevice(device, m_rootPath);
+    root.ok = device->isReadable();
+    m_files.insert(m_rootPath, root);
+
+    return load({}, handler);
+}
+
+// Re-tokenize only the changed files and replay; other files keep their tokens
+bool KeybindParser::reparseFiles(const QStringList &changedPaths, const ItemHandler &handler)
+{
+    if (m_rootPath.isEmpty()) {
+        return false;
+    }
+
+    QStringList wave;
+    for (const QString &path : changedPaths) {
+        if (m_files.remove(path)) {
+            wave.append(path);
+        }
+    }
+
+    qDebug() << "Re-parsing" << wave.size() << "changed config files";
+    return load(wave, handler);
+}
+
+// Tokenize the given files plus any newly reachable sources, then replay
+bool KeybindParser::load(QStringList wave, const ItemHandler &handler)
+{
+    // Globs of files that are kept may match different files by now
+    QSet<QString> seen(wave.cbegin(), wave.cend());
+    for (auto it = m_files.begin(); it != m_files.end(); ++it) {
+        seen.insert(it.key());
+    }
+    for (auto it = m_files.begin(); it != m_files.end(); ++it) {
+        resolveSources(&it.value());
+        queueSources(it.value(), &seen, &wave);
+    }
+
+    // Tokenize the include graph wave by wave. Files discovered in the same
+    // wave do not depend on each other, so they are parsed concurrently.
+    QThreadPool pool;
+    while (!wave.isEmpty()) {
+        std::vector<ParsedConfigFile> parsed(size_t(wave.size()));
+        if (wave.size() == 1) {
+            parsed[0] = tokenizeFile(wave.first());
+        } else {
+            for (int i = 0; i < wave.size(); ++i) {
+                const QString path = wave.at(i);
+                ParsedConfigFile *slot = &parsed[size_t(i)];
+                pool.start([slot, path]() {
+                    *slot = tokenizeFile(path);
+                });
+            }
+            pool.waitForDone();
+        }
+
+        QStringList next;
+        for (ParsedConfigFile &file : parsed) {
+            resolveSources(&file);
+            queueSources(file, &seen, &next);
+            m_files.insert(file.path, file);
+        }
+        wave = next;
+    }
+
+    if (!m_files.value(m_rootPath).ok) {
+        qWarning() << "Could not open config file:" << m_rootPath;
+        return false;
+    }
+
+    // Replay the entries in load order so variables apply across files
+    m_sourceFiles.clear();
+    QMap<QString, QString> variables;
+    QStringList stack;
+    int count = 0;
+    replay(m_rootPath, &variables, &stack, handler, &count);
+    m_sourceFiles.removeDuplicates();
+
+    qDebug() << "Loaded" << count << "keybinds from" << m_files.size() << "files";
+    return true;
+}
+
+// Append the sources of file that have not been seen yet to wave
+void KeybindParser::queueSources(const ParsedConfigFile &file, QSet<QString> *seen, QStringList *wave)
+{
+    for (const ConfigEntry &entry : file.entries) {
+        if (entry.type != ConfigEntry::Source) {
+            continue;
+        }
+        for (const QString &source : entry.sources) {
+            if (!seen->contains(source)) {
+                seen->insert(source);
+                wave->append(source);
+            }
+        }
+    }
+}
+
+// Tokenize a single file without following its sources
+ParsedConfigFile KeybindParser::tokenizeFile(const QString &path)
+{
+    ParsedConfigFile result;
+    result.path = path;
+
+    QFile file(path);
+
+    // Try to open the file
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open config file:" << path;
+        return result;
+    }
+
+    // Scan the mapped bytes in place; fall back to reading for files that
+    // cannot be mapped (empty files, pipes, /proc)
+    const qint64 size = file.size();
+    if (uchar *mapped = size > 0 ? file.map(0, size) : nullptr) {
+        result = tokenizeData(QByteArrayView(mapped, size), path);
+        file.unmap(mapped);
+    } else {
+        result = tokenizeData(file.readAll(), path);
+    }
+    return result;
+}
+
+// Tokenize config text read from an open device; path names it in the result
+ParsedConfigFile KeybindParser::tokenizeDevice(QIODevice *device, const QString &path)
+{
+    return tokenizeData(device->readAll(), path);
+}
+
+namespace {
+
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+QByteArrayView trimmedView(QByteArrayView text)
+{
+    qsizetype begin = 0;
+    qsizetype end = text.size();
+    while (begin < end && isBlank(text[begin]))
+        ++begin;
+    while (end > begin && isBlank(text[end - 1]))
+        --end;
+    return text.sliced(begin, end - begin);
+}
+
+// Cut a trailing "# comment". As in Hyprland, "##" is an escaped '#';
+// *escaped is set if the kept text contains one.
+QByteArrayView stripComment(QByteArrayView line, bool *escaped)
+{
+    *escaped = false;
+    for (qsizetype i = 0; i < line.size(); ++i) {
+        if (line[i] != '#')
+            continue;
+        if (i + 1 < line.size() && line[i + 1] == '#') {
+            *escaped = true;
+            ++i;
+            continue;
+        }
+        return trimmedView(line.first(i));
+    }
+    return line;
+}
+
+// The only point where bytes become a QString
+QString field(QByteArrayView text, bool escaped)
+{
+    QString value = QString::fromUtf8(trimmedView(text));
+    if (escaped)
+        value.replace(QLatin1String("##"), QLatin1String("#"));
+    return value;
+}
+
+// Offset of the next ',' at or after from that is not inside double quotes,
+// or -1
+qsizetype nextSeparator(QByteArrayView text, qsizetype from)
+{
+    bool quoted = false;
+    for (qsizetype i = from; i < text.size(); ++i) {
+        if (text[i] == '"')
+            quoted = !quoted;
+        else if (text[i] == ',' && !quoted)
+            return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+// Tokenize UTF-8 config text. Lines and fields are views into data; only
+// the fields kept in an entry are converted to QString.
+ParsedConfigFile KeybindParser::tokenizeData(QByteArrayView data, const QString &path)
+{
+    ParsedConfigFile result;
+    result.path = path;
+    result.ok = true;
+
+    // Skip a UTF-8 byte order mark
+    if (data.startsWith("\xEF\xBB\xBF"))
+        data = data.sliced(3);
+
+    QByteArrayView lastIcon;
+
+    // Parse the file line by line
+    qsizetype pos = 0;
+    while (pos < data.size()) {
+        const char *start = data.data() + pos;
+        const void *newline = std::memchr(start, '\n', size_t(data.size() - pos));
+        const qsizetype length = newline ? static_cast<const char *>(newline) - start : data.size() - pos;
+        pos += length + 1;
+
+        // Trimming also drops the '\r' of CRLF line endings
+        QByteArrayView line = trimmedView(QByteArrayView(start, length));
+
+        // Handle icon comments
+        if (line.startsWith("## ICON:")) {
+            lastIcon = line.sliced(8);
+            continue;
+        }
+
+        bool escaped = false;
+        line = stripComment(line, &escaped);
+
+        // Skip empty lines
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        // Handle variable definitions
+        if (line.startsWith('$')) {
+            const qsizetype equalPos = line.indexOf('=');
+            if (equalPos != -1) {
+                ConfigEntry entry;
+                entry.type = ConfigEntry::Variable;
+                entry.name = field(line.first(equalPos), escaped);
+                entry.value = field(line.sliced(equalPos + 1), escaped);
+                result.entries.append(entry);
+            }
+            continue;
+        }
+
+        // Handle source directives
+        if (line.startsWith("source") && trimmedView(line.sliced(6)).startsWith('=')) {
+            ConfigEntry entry;
+            entry.type = ConfigEntry::Source;
+            entry.value = field(line.sliced(line.indexOf('=') + 1), escaped);
+            result.entries.append(entry);
+            continue;
+        }
+
+        // Handle bind commands (bind, bindm, bindel, ...)
+        if (line.startsWith("bind")) {
+            const qsizetype equalPos = line.indexOf('=');
+            if (equalPos == -1) continue;
+
+            const QByteArrayView bindingData = trimmedView(line.sliced(equalPos + 1));
+
+            // modifiers, key, dispatcher[, params]; params keep their commas
+            const qsizetype first = nextSeparator(bindingData, 0);
+            const qsizetype second = first == -1 ? -1 : nextSeparator(bindingData, first + 1);
+            if (second == -1) continue;
+            const qsizetype third = nextSeparator(bindingData, second + 1);
+
+            // Keep the raw fields; variables are resolved in load order
+            ConfigEntry entry;
+            entry.type = ConfigEntry::Bind;
+            entry.name = field(bindingData.first(first), escaped);
+            entry.value = field(bindingData.sliced(first + 1, second - first - 1), escaped);
+            if (third == -1) {
+                entry.dispatcher = field(bindingData.sliced(second + 1), escaped);
+            } else {
+                entry.dispatcher = field(bindingData.sliced(second + 1, third - second - 1), escaped);
+                entry.params = field(bindingData.sliced(third + 1), escaped);
+            }
+
+            // Set icon if available, then reset it for the next binding
+            entry.icon = field(lastIcon, false);
+            lastIcon = QByteArrayView();
+
+            result.entries.append(entry);
+        }
+    }
+
+    return result;
+}
+
+// Expand "~" and glob characters; relative patterns start at baseDir
+QStringList KeybindParser::expandSourcePattern(const QString &pattern, const QString &baseDir, QStringList *globDirs)
+{
+    QString path = pattern.trimmed();
+    if (path == "~" || path.startsWith("~/")) {
+        path = QDir::homePath() + path.mid(1);
+    }
+    if (QDir::isRelativePath(path)) {
+        path = QDir(baseDir).filePath(path);
+    }
+    path = QDir::cleanPath(path);
+
+    static const QRegularExpression globChars("[*?\\[]");
+    if (!path.contains(globChars)) {
+        return { path };
+    }
+
+    // Expand one path component at a time, like glob(3)
+    const QStringList parts = path.split('/', Qt::SkipEmptyParts);
+    QStringList current = { QStringLiteral("/") };
+    for (int i = 0; i < parts.size(); ++i) {
+        const QString &part = parts.at(i);
+        const bool last = i == parts.size() - 1;
+
+        QStringList next;
+        for (const QString &dirPath : std::as_const(current)) {
+            QDir dir(dirPath);
+            if (!part.contains(globChars)) {
+                QString candidate = dir.filePath(part);
+                if (last || QFileInfo(candidate).isDir()) {
+                    next.append(candidate);
+                }
+                continue;
+            }
+
+            // Adding or removing a matching file changes this directory's mtime
+            if (globDirs) {
+                globDirs->append(dir.absolutePath());
+            }
+
+            QDir::Filters filters = last ? QDir::Files : (QDir::Dirs | QDir::NoDotAndDotDot);
+            // Hidden entries only match patterns that start with a dot
+            if (part.startsWith('.')) {
+                filters |= QDir::Hidden;
+            }
+            const QStringList entries = dir.entryList({ part }, filters, QDir::Name);
+            for (const QString &entry : entries) {
+                next.append(dir.filePath(entry));
+            }
+        }
+        current = next;
+    }
+    return current;
+}
+
+// Expand the patterns of a file's source entries into canonical paths
+void KeybindParser::resolveSources(ParsedConfigFile *file)
+{
+    const QString baseDir = QFileInfo(file->path).absolutePath();
+    file->globDirs.clear();
+    for (ConfigEntry &entry : file->entries) {
+        if (entry.type != ConfigEntry::Source) {
+            continue;
+        }
+
+        entry.sources.clear();
+        const QStringList paths = expandSourcePattern(entry.value, baseDir, &file->globDirs);
+
+        for (const QString &path : paths) {
+            QString canonical = QFileInfo(path).canonicalFilePath();
+            entry.sources.append(canonical.isEmpty() ? path : canonical);
+        }
+    }
+}
+
+// Emit the binds of path and the files it sources, depth first
+void KeybindParser::replay(const QString &path, QMap<QString, QString> *variables, QStringList *stack,
+                           const ItemHandler &handler, int *count)
+{
+    // Missing files are recorded too, so creating one invalidates the cache
+    m_sourceFiles.append(path);
+
+    auto it = m_files.constFind(path);
+    if (it == m_files.constEnd() || !it->ok) {
+        return;
+    }
+
+    // Adding or removing a file that matches a glob changes its directory's mtime
+    m_sourceFiles.append(it->globDirs);
+
+    stack->append(path);
+    for (const ConfigEntry &entry : it->entries) {
+        switch (entry.type) {
+        case ConfigEntry::Variable:
+            variables->insert(entry.name, entry.value);
+            break;
+        case ConfigEntry::Bind:
+            handler(makeItem(entry, *variables));
+            ++*count;
+            break;
+        case ConfigEntry::Source:
+            for (const QString &source : entry.sources) {
+                if (stack->contains(source)) {
+                    qWarning() << "Skipping cyclic source:" << (QStringList(*stack) << source).join(" -> ");
+                    continue;
+                }
+                replay(source, variables, stack, handler, count);
+            }
+            break;
+        }
+    }
+    stack->removeLast();
+}
+
+// Build the displayed item for a bind entry
+KeybindItem KeybindParser::makeItem(const ConfigEntry &entry, const QMap<QString, QString> &variables) const
+{
+    KeybindItem item;
+
+    // Extract modifiers and key
+    QString modifiers = entry.name;
+    QString key = entry.value;
+    
+    // Resolve variables; going backwards through the sorted names replaces
+    // $mainModShift before $mainMod can eat its prefix
+    for (auto it = variables.constEnd(); it != variables.constBegin();) {
+        --it;
+        modifiers.replace(it.key(), it.value());
+        key.replace(it.key(), it.value());
+    }
+    
+    // Format the keybind display, spelling the same chord the same way
+    item.keybind = KeyChord::displayText(modifiers.trimmed(), key.trimmed());
+    
+    // Extract dispatcher and parameters
+    const QString &dispatcher = entry.dispatcher;
+    const QString &params = entry.params;
+    
+    // Set name and description based on dispatcher and params
+    if (dispatcher == "exec" && !params.isEmpty()) {
+        // For exec commands, try to extract a meaningful name
+        QString command = params;
+        
+        // Remove common prefixes
+        if (command.startsWith("\"")) command = command.mid(1);
+        if (command.endsWith("\"")) command = command.left(command.length() - 1);
+        
+        // Extract command name from path
+        QStringList commandParts = command.split(' ');
+        QString executable = commandParts.first();
+        QFileInfo fileInfo(executable);
+        QString commandName = fileInfo.baseName();
+        
+        // Name, icon and comment from the desktop entry index, the
+        // built-in names or the user's overrides
+        const DesktopEntry app = m_desktopEntries ? m_desktopEntries->resolve(fileInfo.fileName())
+                                                  : DesktopEntryIndex::builtin(fileInfo.fileName());
+        if (!app.name.isEmpty()) {
+            item.name = app.name;
+        } else {
+            // Capitalize first letter
+            if (!commandName.isEmpty()) {
+                commandName[0] = commandName[0].toUpper();
+            }
+            item.name = commandName;
+        }
+        // Paths and themed names are both resolved by the icon provider
+        item.icon = app.icon;
+
+        item.description = app.comment.isEmpty() ? "Execute: " + command
+                                                 : app.comment + " - " + command;
+    } else {
+        // For other dispatchers, use the dispatcher name as the name
+        item.name = dispatcher;
+        // Capitalize first letter
+        if (!item.name.isEmpty()) {
+            item.name[0] = item.name[0].toUpper();
+        }
+        
+        // Create description from dispatcher and params
+        item.description = dispatcher;
+        if (!params.isEmpty()) {
+            item.description += " " + params;
+        }
+    }
+
+    item.dispatcher = dispatcher;
+
+    // An explicit "## ICON:" wins over the desktop entry's icon
+    if (!entry.icon.isEmpty()) {
+        item.icon = entry.icon;
+    }
+    return item;
+}
+
+QStringList KeybindParser::sourceFiles() const
+{
+    return m_sourceFiles;
+}
+
+KeybindItem KeybindParser::bindItem(const ConfigEntry &entry) const
+{
+    return makeItem(entry, QMap<QString, QString>());
+}
+
+void KeybindParser::setDesktopEntries(const DesktopEntryIndex *index)
+{
+    m_desktopEntries = index;
+}
+
+// Sample keybinds used when no config file is available
+QList<KeybindItem> KeybindParser::sampleData()
+{
+    QList<KeybindItem> keybinds;
+    
+    // Add sample keybinds in Hyprland format
+    keybinds.append({"Terminal", "SUPER + Return", "Execute: kitty", "", "exec"});
+    keybinds.append({"File Manager", "SUPER + E", "Execute: thunar", "", "exec"});
+    keybinds.append({"Browser", "SUPER + W", "Execute: firefox", "", "exec"});
+    keybinds.append({"Code Editor", "SUPER + C", "Execute: code", "", "exec"});
+    keybinds.append({"Application Launcher", "SUPER + A", "Execute: walker", "", "exec"});
+    keybinds.append({"Screenshot", "SUPER + S", "Execute: hyprshot -m output", "", "exec"});
+    keybinds.append({"Color Picker", "SUPER + P", "Execute: hyprpicker -a", "", "exec"});
+    keybinds.append({"System Monitor", "SUPER + T", "Execute: kitty -e btop", "", "exec"});
+    keybinds.append({"Kill Active Window", "SUPER + Q", "Kill active window", "", "killactive"});
+    keybinds.append({"Toggle Floating", "SUPER + H", "Toggle floating mode", "", "togglefloating"});
+    keybinds.append({"Workspace 1", "SUPER + 1", "Switch to workspace 1", "", "workspace"});
+    keybinds.append({"Workspace 2", "SUPER + 2", "Switch to workspace 2", "", "workspace"});
+    keybinds.append({"Move to Workspace 1", "SUPER + SHIFT + 1", "Move window to workspace 1", "", "movetoworkspace"});
+    keybinds.append({"Resize Width +", "SUPER + =", "Resize active window", "", "resizeactive"});
+    keybinds.append({"Next Workspace", "SUPER + Mouse Wheel Up", "Switch to next workspace", "", "workspace"});
+    keybinds.append({"Previous Workspace", "SUPER + Mouse Wheel Down", "Switch to previous workspace", "", "workspace"});
+    keybinds.append({"Move Window", "SUPER + LMB", "Move window with mouse", "", "movewindow"});
+    keybinds.append({"Resize Window", "SUPER + RMB", "Resize window with mouse", "", "resizewindow"});
+    keybinds.append({"Volume Up", "XF86AudioRaiseVolume", "Increase volume", "", "exec"});
+    keybinds.append({"Volume Down", "XF86AudioLowerVolume", "Decrease volume", "", "exec"});
+    
+    return keybinds;
+}
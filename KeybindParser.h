@@ -0,0 +1,107 @@
+#ifndef KEYBINDPARSER_H
+#define KEYBINDPARSER_H
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QIODevice>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include "KeybindItem.h"
+
+class DesktopEntryIndex;
+
+// One meaningful line of a config file, before variables are applied
+struct ConfigEntry {
+    enum Type {
+        Variable,   // $name = value
+        Bind,       // bind* = modifiers, key, dispatcher, params
+        Source      // source = path or glob
+    };
+
+    Type type;
+    QString name;           // Variable name, or bind modifiers
+    QString value;          // Variable value, bind key, or source pattern
+    QString dispatcher;
+    QString params;
+    QString icon;           // From a preceding "## ICON:" comment
+    QStringList sources;    // Files a Source entry expanded to, in glob order
+};
+
+// Entries of one config file in file order
+struct ParsedConfigFile {
+    QString path;
+    bool ok = false;
+    QList<ConfigEntry> entries;
+    QStringList globDirs;   // Directories its source globs were expanded in
+};
+
+// Parser for Hyprland bind lines. It has no QObject state, so it can run
+// on any thread.
+//
+// parseFile() follows "source =" directives: every reachable file is
+// tokenized, independent files concurrently on a thread pool, and the
+// entries are then replayed in Hyprland's load order (a sourced file's
+// lines take the place of the source line), so variables defined earlier
+// apply to later files. Sourcing a file that is already being loaded is
+// reported as a cycle and skipped. The tokens of every file are kept, so
+// reparseFiles() only has to read the files that changed.
+class KeybindParser
+{
+public:
+    using ItemHandler = std::function<void(const KeybindItem &item)>;
+
+    // Find the configuration file to read, or an empty string if there is none
+    static QString findConfigFile();
+
+    // Sample keybinds used when no config file is available
+    static QList<KeybindItem> sampleData();
+
+    // Parse configPath and everything it sources, passing every keybind to
+    // handler in load order
+    bool parseFile(const QString &configPath, const ItemHandler &handler);
+
+    // Same as parseFile(), for config text from an already open device
+    bool parseDevice(QIODevice *device, const ItemHandler &handler);
+
+    // Re-read only changedPaths (and newly sourced files) and replay all
+    // binds; returns false if nothing has been parsed yet
+    bool reparseFiles(const QStringList &changedPaths, const ItemHandler &handler);
+
+    // Files read by the last parse, plus the directories globs were expanded in
+    QStringList sourceFiles() const;
+
+    // Displayed item for a bind that did not come from a config file,
+    // with variables already applied
+    KeybindItem bindItem(const ConfigEntry &entry) const;
+
+    // Index used to name exec binds; without one only built-in names apply.
+    // The index must outlive the parser.
+    void setDesktopEntries(const DesktopEntryIndex *index);
+
+    // Tokenize a single file without following its sources
+    static ParsedConfigFile tokenizeFile(const QString &path);
+    static ParsedConfigFile tokenizeDevice(QIODevice *device, const QString &path);
+    static ParsedConfigFile tokenizeData(QByteArrayView data, const QString &path);
+
+    // Expand "~" and glob characters; relative patterns start at baseDir
+    static QStringList expandSourcePattern(const QString &pattern, const QString &baseDir, QStringList *globDirs = nullptr);
+
+private:
+    bool load(QStringList wave, const ItemHandler &handler);
+    static void queueSources(const ParsedConfigFile &file, QSet<QString> *seen, QStringList *wave);
+    void resolveSources(ParsedConfigFile *file);
+    void replay(const QString &path, QMap<QString, QString> *variables, QStringList *stack,
+                const ItemHandler &handler, int *count);
+    KeybindItem makeItem(const ConfigEntry &entry, const QMap<QString, QString> &variables) const;
+
+    QString m_rootPath;
+    QHash<QString, ParsedConfigFile> m_files;
+    QStringList m_sourceFiles;
+    const DesktopEntryIndex *m_desktopEntries = nullptr;
+};
+
+#endif // KEYBINDPARSER_H
@@ -0,0 +1,414 @@
+#include "KeybindRowItem.h"
+#include <QDebug>
+#include <QFontMetricsF>
+#include <QGuiApplication>
+#include <QPainter>
+#include <QPointer>
+#include <QQmlEngine>
+#include <QQuickAsyncImageProvider>
+#include <QQuickWindow>
+#include <QTextCharFormat>
+#include <QUrl>
+#include <QtMath>
+
+namespace {
+
+// Geometry of the QML delegate this item replaces
+const qreal Margin = 10;            // RowLayout anchors.margins
+const qreal ColumnSpacing = 5;      // RowLayout default spacing
+const qreal KeybindColumnWidth = 150;
+const qreal NameColumnWidth = 200;
+const qreal IconSize = 20;
+const qreal IconSpacing = 8;        // Row spacing between icon and keybind
+const int FontPixelSize = 14;
+
+const QString Placeholder = QStringLiteral("🔍");
+
+// Bold, colored formats for the [start, length, ...] ranges that fall
+// inside the first length characters
+QList<QTextLayout::FormatRange> highlightFormats(const QVariantList &ranges, const QColor &color, int length)
+{
+    QList<QTextLayout::FormatRange> formats;
+    for (int i = 0; i + 1 < ranges.size(); i += 2) {
+        const int start = ranges.at(i).toInt();
+        const int end = qMin(start + ranges.at(i + 1).toInt(), length);
+        if (start < 0 || start >= end) {
+            continue;
+        }
+        QTextLayout::FormatRange range;
+        range.start = start;
+        range.length = end - start;
+        range.format.setFontWeight(QFont::Bold);
+        range.format.setForeground(color);
+        formats.append(range);
+    }
+    return formats;
+}
+
+// Break the text of layout into lines of width, or one unbounded line for
+// a negative width; returns the number of lines
+int layoutLines(QTextLayout *layout, qreal width)
+{
+    QTextOption option;
+    option.setWrapMode(width < 0 ? QTextOption::NoWrap : QTextOption::WordWrap);
+    layout->setTextOption(option);
+
+    qreal y = 0;
+    layout->beginLayout();
+    for (QTextLine line = layout->createLine(); line.isValid(); line = layout->createLine()) {
+        if (width >= 0) {
+            line.setLineWidth(width);
+        }
+        line.setPosition(QPointF(0, y));
+        y += line.height();
+    }
+    layout->endLayout();
+    return layout->lineCount();
+}
+
+} // namespace
+
+// Constructor
+KeybindRowItem::KeybindRowItem(QQuickItem *parent)
+    : QQuickPaintedItem(parent)
+    , m_radius(6)
+    , m_iconState(NoIcon)
+    , m_iconResponse(nullptr)
+    , m_iconDirty(false)
+{
+    m_font = QGuiApplication::font();
+    m_font.setPixelSize(FontPixelSize);
+    m_boldFont = m_font;
+    m_boldFont.setBold(true);
+    setAntialiasing(true);
+}
+
+KeybindRowItem::~KeybindRowItem()
+{
+    cancelIcon();
+}
+
+void KeybindRowItem::setName(const QString &name)
+{
+    if (m_name == name) {
+        return;
+    }
+    m_name = name;
+    m_nameText.dirty = true;
+    polish();
+    emit nameChanged();
+}
+
+void KeybindRowItem::setKeybind(const QString &keybind)
+{
+    if (m_keybind == keybind) {
+        return;
+    }
+    m_keybind = keybind;
+    m_keybindText.dirty = true;
+    polish();
+    emit keybindChanged();
+}
+
+void KeybindRowItem::setDescription(const QString &description)
+{
+    if (m_description == description) {
+        return;
+    }
+    m_description = description;
+    m_descriptionText.dirty = true;
+    polish();
+    emit descriptionChanged();
+}
+
+void KeybindRowItem::setIcon(const QString &icon)
+{
+    if (m_icon == icon) {
+        return;
+    }
+    m_icon = icon;
+    m_iconDirty = true;
+    polish();
+    emit iconChanged();
+}
+
+void KeybindRowItem::setMatchRanges(const QVariantMap &ranges)
+{
+    if (m_matchRanges == ranges) {
+        return;
+    }
+    m_matchRanges = ranges;
+    invalidateText();
+    emit matchRangesChanged();
+}
+
+void KeybindRowItem::setColor(const QColor &color)
+{
+    if (m_color == color) {
+        return;
+    }
+    m_color = color;
+    update();
+    emit colorChanged();
+}
+
+// The text colors are part of the highlight formats, so they reshape
+void KeybindRowItem::setPrimaryColor(const QColor &color)
+{
+    if (m_primaryColor == color) {
+        return;
+    }
+    m_primaryColor = color;
+    invalidateText();
+    emit colorChanged();
+}
+
+void KeybindRowItem::setSecondaryColor(const QColor &color)
+{
+    if (m_secondaryColor == color) {
+        return;
+    }
+    m_secondaryColor = color;
+    update();
+    emit colorChanged();
+}
+
+void KeybindRowItem::setAccentColor(const QColor &color)
+{
+    if (m_accentColor == color) {
+        return;
+    }
+    m_accentColor = color;
+    invalidateText();
+    emit colorChanged();
+}
+
+void KeybindRowItem::setTextColor(const QColor &color)
+{
+    if (m_textColor == color) {
+        return;
+    }
+    m_textColor = color;
+    update();
+    emit colorChanged();
+}
+
+void KeybindRowItem::setRadius(qreal radius)
+{
+    if (qFuzzyCompare(m_radius, radius)) {
+        return;
+    }
+    m_radius = radius;
+    update();
+    emit radiusChanged();
+}
+
+void KeybindRowItem::invalidateText()
+{
+    m_keybindText.dirty = true;
+    m_nameText.dirty = true;
+    m_descriptionText.dirty = true;
+    polish();
+}
+
+void KeybindRowItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    // Icons are requested in device pixels
+    if ((change == ItemSceneChange && value.window) || change == ItemDevicePixelRatioHasChanged) {
+        m_iconDirty = true;
+        polish();
+    }
+    QQuickPaintedItem::itemChange(change, value);
+}
+
+void KeybindRowItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    // Only the description wraps; the keybind and the name keep their width
+    if (!qFuzzyCompare(newGeometry.width(), oldGeometry.width())
+        || !qFuzzyCompare(newGeometry.height(), oldGeometry.height())) {
+        m_descriptionText.dirty = true;
+        polish();
+    }
+    QQuickPaintedItem::geometryChange(newGeometry, oldGeometry);
+}
+
+// Shape whatever changed since the last frame; paint() only draws
+void KeybindRowItem::updatePolish()
+{
+    if (m_iconDirty) {
+        m_iconDirty = false;
+        requestIcon();
+    }
+
+    if (m_keybindText.dirty) {
+        shape(&m_keybindText, m_keybind, m_matchRanges.value(QStringLiteral("keybind")).toList(),
+              m_boldFont, m_primaryColor, -1, 1);
+    }
+    if (m_nameText.dirty) {
+        shape(&m_nameText, m_name, m_matchRanges.value(QStringLiteral("name")).toList(),
+              m_font, m_accentColor, NameColumnWidth, 1);
+    }
+    if (m_descriptionText.dirty) {
+        // As many lines as fit the row; the QML Text drew past its bottom
+        const qreal left = Margin + KeybindColumnWidth + ColumnSpacing + NameColumnWidth + ColumnSpacing;
+        const qreal width = qMax<qreal>(0, this->width() - Margin - left);
+        const int maxLines = qMax(1, int(height() / QFontMetricsF(m_font).height()));
+        shape(&m_descriptionText, m_description, m_matchRanges.value(QStringLiteral("description")).toList(),
+              m_font, m_accentColor, width, maxLines);
+    }
+    update();
+}
+
+void KeybindRowItem::shape(TextBlock *block, const QString &text, const QVariantList &ranges,
+                           const QFont &font, const QColor &highlight, qreal width, int maxLines)
+{
+    QTextLayout &layout = block->layout;
+    layout.setFont(font);
+    layout.setText(text);
+    layout.setFormats(highlightFormats(ranges, highlight, int(text.size())));
+    int lines = layoutLines(&layout, width);
+
+    const auto overflows = [&layout, width, maxLines](int lineCount) {
+        return lineCount > maxLines
+            || (width >= 0 && lineCount > 0 && layout.lineAt(lineCount - 1).naturalTextWidth() > width);
+    };
+
+    if (width >= 0 && overflows(lines)) {
+        // Elide the last line that fits; the elided text is measured in the
+        // regular font, so drop characters while bold ranges still overflow
+        const int lastStart = layout.lineAt(qMin(lines, maxLines) - 1).textStart();
+        QString kept = QFontMetricsF(font).elidedText(text.mid(lastStart), Qt::ElideRight, width);
+        kept.chop(1);
+        do {
+            const QString shown = text.left(lastStart) + kept + QChar(0x2026);
+            layout.setText(shown);
+            layout.setFormats(highlightFormats(ranges, highlight, lastStart + int(kept.size())));
+            lines = layoutLines(&layout, width);
+            if (kept.isEmpty()) {
+                break;
+            }
+            kept.chop(1);
+        } while (overflows(lines));
+    }
+
+    qreal textWidth = 0;
+    qreal textHeight = 0;
+    for (int i = 0; i < qMin(lines, maxLines); ++i) {
+        const QTextLine line = layout.lineAt(i);
+        textWidth = qMax(textWidth, line.naturalTextWidth());
+        textHeight += line.height();
+    }
+    block->size = QSizeF(textWidth, textHeight);
+    block->dirty = false;
+}
+
+void KeybindRowItem::requestIcon()
+{
+    cancelIcon();
+    m_iconImage = QImage();
+    if (m_icon.isEmpty()) {
+        m_iconState = NoIcon;
+        return;
+    }
+
+    QQmlEngine *engine = qmlEngine(this);
+    auto *provider = engine
+        ? dynamic_cast<QQuickAsyncImageProvider *>(engine->imageProvider(QStringLiteral("keyicon")))
+        : nullptr;
+    if (!provider) {
+        static bool warned = false;
+        if (!warned) {
+            qWarning() << "KeybindRowItem: no keyicon image provider, icons are not shown";
+            warned = true;
+        }
+        m_iconState = IconFailed;
+        return;
+    }
+
+    // Same id and size the Image element requested: the percent-encoded
+    // icon and its sourceSize in device pixels
+    const qreal ratio = window() ? window()->effectiveDevicePixelRatio() : qApp->devicePixelRatio();
+    const int side = qCeil(IconSize * ratio);
+    const QString id = QString::fromLatin1(QUrl::toPercentEncoding(m_icon));
+    QQuickImageResponse *response = provider->requestImageResponse(id, QSize(side, side));
+    m_iconState = IconLoading;
+    m_iconResponse = response;
+
+    // The response finishes on the provider's pool; it is deleted here even
+    // when the row was destroyed or moved on to another icon meanwhile
+    QPointer<KeybindRowItem> self(this);
+    connect(response, &QQuickImageResponse::finished, response, [self, response]() {
+        if (self) {
+            self->iconFinished(response);
+        }
+        response->deleteLater();
+    });
+}
+
+void KeybindRowItem::cancelIcon()
+{
+    if (m_iconResponse) {
+        m_iconResponse->cancel();
+        m_iconResponse = nullptr;
+    }
+}
+
+void KeybindRowItem::iconFinished(QQuickImageResponse *response)
+{
+    if (response != m_iconResponse) {
+        return;
+    }
+    m_iconResponse = nullptr;
+
+    // The caller owns the texture factory
+    QQuickTextureFactory *factory = response->errorString().isEmpty() ? response->textureFactory() : nullptr;
+    m_iconImage = factory ? factory->image() : QImage();
+    delete factory;
+    m_iconState = m_iconImage.isNull() ? IconFailed : IconReady;
+    update();
+}
+
+void KeybindRowItem::paint(QPainter *painter)
+{
+    painter->setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+
+    // Background
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(m_color);
+    painter->drawRoundedRect(boundingRect(), m_radius, m_radius);
+
+    const qreal centerY = height() / 2;
+
+    // Icon and keybind, centered together in the first column; as in the
+    // QML Row, both are top-aligned and a failed icon takes no space
+    const bool iconSlot = m_iconState != IconFailed;
+    const qreal slotWidth = iconSlot ? IconSize + IconSpacing : 0;
+    const qreal rowWidth = slotWidth + m_keybindText.size.width();
+    const qreal rowHeight = qMax(iconSlot ? IconSize : 0, m_keybindText.size.height());
+    const QPointF rowTopLeft(Margin + (KeybindColumnWidth - rowWidth) / 2, centerY - rowHeight / 2);
+    const QRectF iconRect(rowTopLeft, QSizeF(IconSize, IconSize));
+
+    if (m_iconState == IconReady) {
+        QSizeF size = m_iconImage.size();
+        size.scale(iconRect.size(), Qt::KeepAspectRatio);
+        QRectF target(QPointF(), size);
+        target.moveCenter(iconRect.center());
+        painter->drawImage(target, m_iconImage);
+    } else if (m_iconState == NoIcon) {
+        painter->setFont(m_font);
+        painter->setPen(m_accentColor);
+        painter->drawText(iconRect, Qt::AlignCenter, Placeholder);
+    }
+
+    painter->setPen(m_accentColor);
+    m_keybindText.layout.draw(painter, rowTopLeft + QPointF(slotWidth, 0));
+
+    // Name and description, vertically centered in their columns
+    const qreal nameLeft = Margin + KeybindColumnWidth + ColumnSpacing;
+    painter->setPen(m_secondaryColor);
+    m_nameText.layout.draw(painter, QPointF(nameLeft, centerY - m_nameText.size.height() / 2));
+
+    const qreal descriptionLeft = nameLeft + NameColumnWidth + ColumnSpacing;
+    painter->setPen(m_textColor);
+    m_descriptionText.layout.draw(painter, QPointF(descriptionLeft, centerY - m_descriptionText.size.height() / 2));
+}
@@ -0,0 +1,137 @@
+#ifndef KEYBINDROWITEM_H
+#define KEYBINDROWITEM_H
+
+#include <QQuickPaintedItem>
+#include <QtQml/qqml.h>
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QString>
+#include <QTextLayout>
+#include <QVariantList>
+#include <QVariantMap>
+
+class QQuickImageResponse;
+
+// One row of the keybind list, drawn by a single item.
+//
+// Replaces the QML delegate (a Rectangle, a RowLayout, a Row, an Image and
+// four Text elements with StyledText markup) with the same picture: the
+// rounded background, the icon or the placeholder, the bold keybind, the
+// elided name and the wrapped description, with matched ranges in bold and
+// the highlight color. Text is shaped into QTextLayouts on the GUI thread
+// when a property or the width changes, and paint() only draws the cached
+// glyph runs, so scrolling through reused rows does no markup parsing and
+// no layout work. Icons come from the "keyicon" provider of the engine, as
+// they did for the Image element.
+class KeybindRowItem : public QQuickPaintedItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(QString keybind READ keybind WRITE setKeybind NOTIFY keybindChanged)
+    Q_PROPERTY(QString description READ description WRITE setDescription NOTIFY descriptionChanged)
+    Q_PROPERTY(QString icon READ icon WRITE setIcon NOTIFY iconChanged)
+    Q_PROPERTY(QVariantMap matchRanges READ matchRanges WRITE setMatchRanges NOTIFY matchRangesChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor primaryColor READ primaryColor WRITE setPrimaryColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor secondaryColor READ secondaryColor WRITE setSecondaryColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor accentColor READ accentColor WRITE setAccentColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor textColor READ textColor WRITE setTextColor NOTIFY colorChanged)
+    Q_PROPERTY(qreal radius READ radius WRITE setRadius NOTIFY radiusChanged)
+
+public:
+    explicit KeybindRowItem(QQuickItem *parent = nullptr);
+    ~KeybindRowItem() override;
+
+    QString name() const { return m_name; }
+    QString keybind() const { return m_keybind; }
+    QString description() const { return m_description; }
+    QString icon() const { return m_icon; }
+    QVariantMap matchRanges() const { return m_matchRanges; }
+    QColor color() const { return m_color; }
+    QColor primaryColor() const { return m_primaryColor; }
+    QColor secondaryColor() const { return m_secondaryColor; }
+    QColor accentColor() const { return m_accentColor; }
+    QColor textColor() const { return m_textColor; }
+    qreal radius() const { return m_radius; }
+
+    void setName(const QString &name);
+    void setKeybind(const QString &keybind);
+    void setDescription(const QString &description);
+    void setIcon(const QString &icon);
+    void setMatchRanges(const QVariantMap &ranges);
+    void setColor(const QColor &color);
+    void setPrimaryColor(const QColor &color);
+    void setSecondaryColor(const QColor &color);
+    void setAccentColor(const QColor &color);
+    void setTextColor(const QColor &color);
+    void setRadius(qreal radius);
+
+    void paint(QPainter *painter) override;
+
+signals:
+    void nameChanged();
+    void keybindChanged();
+    void descriptionChanged();
+    void iconChanged();
+    void matchRangesChanged();
+    void colorChanged();
+    void radiusChanged();
+
+protected:
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    void updatePolish() override;
+
+private:
+    enum IconState {
+        NoIcon,         // Placeholder drawn
+        IconLoading,    // Slot kept empty, as the Image was while loading
+        IconReady,
+        IconFailed      // No slot at all, as for an Image in Error
+    };
+
+    // Shaped text of one column; dirty until its inputs are shaped again
+    struct TextBlock {
+        QTextLayout layout;
+        QSizeF size;
+        bool dirty = true;
+    };
+
+    void invalidateText();
+    void requestIcon();
+    void cancelIcon();
+    void iconFinished(QQuickImageResponse *response);
+
+    // Shape text into block, highlighting ranges [start, length, ...] in
+    // bold and highlight; lines beyond maxLines are dropped and the last
+    // kept line is elided to width
+    static void shape(TextBlock *block, const QString &text, const QVariantList &ranges,
+                      const QFont &font, const QColor &highlight, qreal width, int maxLines);
+
+    QString m_name;
+    QString m_keybind;
+    QString m_description;
+    QString m_icon;
+    QVariantMap m_matchRanges;
+    QColor m_color;
+    QColor m_primaryColor;
+    QColor m_secondaryColor;
+    QColor m_accentColor;
+    QColor m_textColor;
+    qreal m_radius;
+
+    QFont m_font;
+    QFont m_boldFont;
+    TextBlock m_keybindText;
+    TextBlock m_nameText;
+    TextBlock m_descriptionText;
+
+    IconState m_iconState;
+    QImage m_iconImage;
+    QQuickImageResponse *m_iconResponse;   // Pending request, owned by itself
+    bool m_iconDirty;
+};
+
+#endif // KEYBINDROWITEM_H
@@ -0,0 +1,132 @@
+#include "KeybindSearchIndex.h"
+
+namespace {
+
+const KeybindStore::Column SearchedColumns[] = {
+    KeybindStore::NameColumn,
+    KeybindStore::KeybindColumn,
+    KeybindStore::DescriptionColumn
+};
+const int SearchedColumnCount = 3;
+
+} // namespace
+
+// Pack three UTF-16 code units into one key
+quint64 KeybindSearchIndex::trigramKey(const QChar *text)
+{
+    return (quint64(text[0].unicode()) << 32)
+         | (quint64(text[1].unicode()) << 16)
+         | quint64(text[2].unicode());
+}
+
+void KeybindSearchIndex::build(const KeybindStore &store)
+{
+    clear();
+
+    // Fold every distinct string once
+    m_folded.reserve(store.stringCount());
+    for (int id = 0; id < store.stringCount(); ++id) {
+        m_folded.append(store.string(quint32(id)).toCaseFolded());
+    }
+
+    m_fields.reserve(size_t(store.size()) * SearchedColumnCount);
+    for (int i = 0; i < store.size(); ++i) {
+        for (KeybindStore::Column column : SearchedColumns) {
+            const quint32 id = store.stringId(i, column);
+            m_fields.push_back(id);
+            addTrigrams(m_folded.at(id), quint32(i));
+        }
+    }
+}
+
+void KeybindSearchIndex::clear()
+{
+    m_folded.clear();
+    m_fields.clear();
+    m_postings.clear();
+}
+
+int KeybindSearchIndex::size() const
+{
+    return int(m_fields.size() / SearchedColumnCount);
+}
+
+qint64 KeybindSearchIndex::memoryUsage() const
+{
+    // Folded strings share their data with the store when folding changed nothing
+    qint64 bytes = qint64(m_folded.capacity()) * qint64(sizeof(QString));
+    for (const QString &text : m_folded) {
+        if (!text.isDetached()) {
+            continue;
+        }
+        bytes += qint64(text.capacity()) * qint64(sizeof(QChar));
+    }
+    bytes += qint64(m_fields.capacity()) * qint64(sizeof(quint32));
+
+    bytes += qint64(m_postings.capacity()) * qint64(sizeof(quint64) + sizeof(std::vector<quint32>) + sizeof(void *));
+    for (const std::vector<quint32> &posting : m_postings) {
+        bytes += qint64(posting.capacity()) * qint64(sizeof(quint32));
+    }
+    return bytes;
+}
+
+void KeybindSearchIndex::addTrigrams(const QString &text, quint32 item)
+{
+    const QChar *data = text.constData();
+    for (qsizetype i = 0; i + 3 <= text.size(); ++i) {
+        std::vector<quint32> &posting = m_postings[trigramKey(data + i)];
+        // Items are added in order, so a duplicate can only be the last entry
+        if (posting.empty() || posting.back() != item) {
+            posting.push_back(item);
+        }
+    }
+}
+
+bool KeybindSearchIndex::matches(quint32 item, const QString &foldedQuery) const
+{
+    const quint32 *fields = m_fields.data() + size_t(item) * SearchedColumnCount;
+    for (int column = 0; column < SearchedColumnCount; ++column) {
+        if (m_folded.at(fields[column]).contains(foldedQuery))
+            return true;
+    }
+    return false;
+}
+
+bool KeybindSearchIndex::search(const QString &query, const std::vector<quint32> *candidates, std::vector<quint32> *result,
+                                const CancelToken &cancel) const
+{
+    result->clear();
+    const QString foldedQuery = query.toCaseFolded();
+
+    // Pick the smallest trigram posting list as the candidate set
+    const std::vector<quint32> *posting = nullptr;
+    const QChar *data = foldedQuery.constData();
+    for (qsizetype i = 0; i + 3 <= foldedQuery.size(); ++i) {
+        auto it = m_postings.constFind(trigramKey(data + i));
+        if (it == m_postings.constEnd()) {
+            // A trigram no item contains: nothing can match
+            return true;
+        }
+        if (!posting || it->size() < posting->size()) {
+            posting = &it.value();
+        }
+    }
+
+    // Queries shorter than a trigram check every item
+    const std::vector<quint32> *items = nullptr;
+    if (candidates && (!posting || candidates->size() <= posting->size())) {
+        items = candidates;
+    } else if (posting) {
+        items = posting;
+    }
+
+    const quint32 count = items ? quint32(items->size()) : quint32(size());
+    for (quint32 i = 0; i < count; ++i) {
+        if (i % CancelToken::CheckInterval == 0 && cancel.cancelled())
+            return false;
+        const quint32 item = items ? (*items)[i] : i;
+        if (foldedQuery.isEmpty() || matches(item, foldedQuery))
+            result->push_back(item);
+    }
+    return true;
+}
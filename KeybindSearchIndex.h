@@ -0,0 +1,45 @@
+#ifndef KEYBINDSEARCHINDEX_H
+#define KEYBINDSEARCHINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <vector>
+#include "CancelToken.h"
+#include "KeybindStore.h"
+
+// Case-folded text and trigram postings for substring filtering.
+//
+// search() returns exactly the items whose name, keybind or description
+// contains the query case-insensitively; the postings only shrink the
+// set of items that have to be checked.
+class KeybindSearchIndex
+{
+public:
+    void build(const KeybindStore &store);
+    void clear();
+
+    int size() const;
+
+    // Approximate heap usage in bytes
+    qint64 memoryUsage() const;
+
+    // Write the matching item indices (ascending) to result.
+    // If candidates is given, only those indices are considered; this is
+    // used to narrow the previous result when a query is extended.
+    // Returns false, with result incomplete, if cancel fired.
+    bool search(const QString &query, const std::vector<quint32> *candidates, std::vector<quint32> *result,
+                const CancelToken &cancel = CancelToken()) const;
+
+private:
+    static quint64 trigramKey(const QChar *text);
+    void addTrigrams(const QString &text, quint32 item);
+    bool matches(quint32 item, const QString &foldedQuery) const;
+
+    // Folded text per interned string, and the string ids of every item
+    QList<QString> m_folded;
+    std::vector<quint32> m_fields;      // Name, keybind, description per item
+    QHash<quint64, std::vector<quint32>> m_postings;
+};
+
+#endif // KEYBINDSEARCHINDEX_H
@@ -0,0 +1,126 @@
+#include "KeybindSortIndex.h"
+#include "ChordIndex.h"
+#include <QCollator>
+#include <algorithm>
+
+namespace {
+
+// Rank of every string id used in a column, in collation order; strings
+// that collate equal share a rank
+std::vector<quint32> collationRanks(const KeybindStore &store, KeybindStore::Column column)
+{
+    std::vector<quint32> ids;
+    std::vector<bool> seen(size_t(store.stringCount()), false);
+    for (int i = 0; i < store.size(); ++i) {
+        const quint32 id = store.stringId(i, column);
+        if (!seen[id]) {
+            seen[id] = true;
+            ids.push_back(id);
+        }
+    }
+
+    QCollator collator;
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    collator.setNumericMode(true);
+
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(ids.size());
+    for (quint32 id : ids) {
+        keys.push_back(collator.sortKey(store.string(id)));
+    }
+
+    std::vector<quint32> order(ids.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = quint32(i);
+    }
+    std::sort(order.begin(), order.end(), [&keys](quint32 a, quint32 b) {
+        return keys[a].compare(keys[b]) < 0;
+    });
+
+    std::vector<quint32> ranks(size_t(store.stringCount()), 0);
+    quint32 rank = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && keys[order[i - 1]].compare(keys[order[i]]) != 0) {
+            ++rank;
+        }
+        ranks[ids[order[i]]] = rank;
+    }
+    return ranks;
+}
+
+} // namespace
+
+void KeybindSortIndex::build(const KeybindStore &store)
+{
+    clear();
+
+    const struct {
+        Key key;
+        KeybindStore::Column column;
+    } textKeys[] = {
+        { NameKey, KeybindStore::NameColumn },
+        { DescriptionKey, KeybindStore::DescriptionColumn },
+        { DispatcherKey, KeybindStore::DispatcherColumn }
+    };
+
+    for (const auto &textKey : textKeys) {
+        const std::vector<quint32> ranks = collationRanks(store, textKey.column);
+        std::vector<quint64> &keys = m_keys[textKey.key];
+        keys.resize(size_t(store.size()));
+        for (int i = 0; i < store.size(); ++i) {
+            keys[size_t(i)] = ranks[store.stringId(i, textKey.column)];
+        }
+    }
+
+    // Chords order by key, then by modifiers, so every SUPER + Q variant
+    // sits together; keybinds that are not chords follow in text order
+    const std::vector<quint32> keybindRanks = collationRanks(store, KeybindStore::KeybindColumn);
+    std::vector<quint64> &chordKeys = m_keys[KeybindKey];
+    chordKeys.resize(size_t(store.size()));
+    const quint64 Unparsed = ~quint64(0);
+    std::vector<quint64> keyOfString(size_t(store.stringCount()), Unparsed);
+    for (int i = 0; i < store.size(); ++i) {
+        const quint32 id = store.stringId(i, KeybindStore::KeybindColumn);
+        quint64 &key = keyOfString[id];
+        if (key == Unparsed) {
+            const KeyChord chord = KeyChord::fromKeybind(store.string(id));
+            key = chord.isValid() ? (quint64(chord.key) << 8) | chord.modifiers
+                                  : (quint64(1) << 62) | keybindRanks[id];
+        }
+        chordKeys[size_t(i)] = key;
+    }
+}
+
+void KeybindSortIndex::clear()
+{
+    for (std::vector<quint64> &keys : m_keys) {
+        keys.clear();
+    }
+}
+
+void KeybindSortIndex::sort(std::vector<quint32> *items, Key key, bool descending) const
+{
+    const std::vector<quint64> &keys = m_keys[key];
+    if (keys.empty()) {
+        return;
+    }
+
+    if (descending) {
+        std::stable_sort(items->begin(), items->end(), [&keys](quint32 a, quint32 b) {
+            return keys[a] > keys[b];
+        });
+    } else {
+        std::stable_sort(items->begin(), items->end(), [&keys](quint32 a, quint32 b) {
+            return keys[a] < keys[b];
+        });
+    }
+}
+
+qint64 KeybindSortIndex::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const std::vector<quint64> &keys : m_keys) {
+        bytes += qint64(keys.capacity()) * qint64(sizeof(quint64));
+    }
+    return bytes;
+}
@@ -0,0 +1,38 @@
+#ifndef KEYBINDSORTINDEX_H
+#define KEYBINDSORTINDEX_H
+
+#include <vector>
+#include "KeybindStore.h"
+
+// Precomputed sort keys for ordering keybinds by a column.
+//
+// build() collates every distinct name, description and dispatcher string
+// once with QCollatorSortKey (case-insensitive, numbers compared by value)
+// and replaces it with its rank, and packs each keybind's chord into an
+// integer. Sorting is then a stable sort over 64-bit keys, with no string
+// comparison at all.
+class KeybindSortIndex
+{
+public:
+    enum Key {
+        KeybindKey,
+        NameKey,
+        DescriptionKey,
+        DispatcherKey,
+        KeyCount
+    };
+
+    void build(const KeybindStore &store);
+    void clear();
+
+    // Order items by key; equal keys keep their current relative order
+    void sort(std::vector<quint32> *items, Key key, bool descending) const;
+
+    // Approximate heap usage in bytes
+    qint64 memoryUsage() const;
+
+private:
+    std::vector<quint64> m_keys[KeyCount];  // Sort key per item and column
+};
+
+#endif // KEYBINDSORTINDEX_H
@@ -0,0 +1,128 @@
+#include "KeybindStore.h"
+
+// Constructor
+KeybindStore::KeybindStore()
+{
+    clear();
+}
+
+int KeybindStore::size() const
+{
+    return int(m_columns[NameColumn].size());
+}
+
+bool KeybindStore::isEmpty() const
+{
+    return m_columns[NameColumn].empty();
+}
+
+void KeybindStore::clear()
+{
+    m_strings.clear();
+    m_ids.clear();
+    for (std::vector<quint32> &column : m_columns) {
+        column.clear();
+    }
+
+    // Id 0 is reserved for the empty string
+    m_strings.append(QString());
+    m_ids.insert(QString(), 0);
+}
+
+void KeybindStore::reserve(int count)
+{
+    for (std::vector<quint32> &column : m_columns) {
+        column.reserve(size_t(count));
+    }
+}
+
+quint32 KeybindStore::intern(const QString &text)
+{
+    if (text.isEmpty()) {
+        return 0;
+    }
+
+    auto it = m_ids.constFind(text);
+    if (it != m_ids.constEnd()) {
+        return it.value();
+    }
+
+    const quint32 id = quint32(m_strings.size());
+    m_strings.append(text);
+    m_ids.insert(text, id);
+    return id;
+}
+
+void KeybindStore::append(const KeybindItem &item)
+{
+    m_columns[NameColumn].push_back(intern(item.name));
+    m_columns[KeybindColumn].push_back(intern(item.keybind));
+    m_columns[DescriptionColumn].push_back(intern(item.description));
+    m_columns[IconColumn].push_back(intern(item.icon));
+    m_columns[DispatcherColumn].push_back(intern(item.dispatcher));
+}
+
+void KeybindStore::append(const QList<KeybindItem> &items)
+{
+    reserve(size() + items.size());
+    for (const KeybindItem &item : items) {
+        append(item);
+    }
+}
+
+const QString &KeybindStore::text(int index, Column column) const
+{
+    return m_strings.at(m_columns[column][size_t(index)]);
+}
+
+quint32 KeybindStore::stringId(int index, Column column) const
+{
+    return m_columns[column][size_t(index)];
+}
+
+const QString &KeybindStore::string(quint32 id) const
+{
+    return m_strings.at(id);
+}
+
+int KeybindStore::stringCount() const
+{
+    return m_strings.size();
+}
+
+KeybindItem KeybindStore::item(int index) const
+{
+    KeybindItem result;
+    result.name = text(index, NameColumn);
+    result.keybind = text(index, KeybindColumn);
+    result.description = text(index, DescriptionColumn);
+    result.icon = text(index, IconColumn);
+    result.dispatcher = text(index, DispatcherColumn);
+    return result;
+}
+
+qint64 KeybindStore::memoryUsage() const
+{
+    return stringBytes() + columnBytes();
+}
+
+qint64 KeybindStore::stringBytes() const
+{
+    qint64 bytes = 0;
+
+    // String payloads plus the QString and hash node overhead
+    for (const QString &text : m_strings) {
+        bytes += qint64(text.capacity()) * qint64(sizeof(QChar)) + qint64(sizeof(QString));
+    }
+    bytes += qint64(m_ids.capacity()) * qint64(sizeof(QString) + sizeof(quint32) + sizeof(void *));
+    return bytes;
+}
+
+qint64 KeybindStore::columnBytes() const
+{
+    qint64 bytes = 0;
+    for (const std::vector<quint32> &column : m_columns) {
+        bytes += qint64(column.capacity()) * qint64(sizeof(quint32));
+    }
+    return bytes;
+}
@@ -0,0 +1,65 @@
+#ifndef KEYBINDSTORE_H
+#define KEYBINDSTORE_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <vector>
+#include "KeybindItem.h"
+
+// Column-wise keybind storage with interned strings.
+//
+// Every distinct string is kept once in an intern table and each field is a
+// column of 32-bit string ids, so repeated descriptions, icons and
+// modifiers cost four bytes per item. Accessors return references to the
+// interned QString, which QVariant shares instead of copying.
+class KeybindStore
+{
+public:
+    enum Column {
+        NameColumn,
+        KeybindColumn,
+        DescriptionColumn,
+        IconColumn,
+        DispatcherColumn,
+        ColumnCount
+    };
+
+    KeybindStore();
+
+    int size() const;
+    bool isEmpty() const;
+    void clear();
+    void reserve(int count);
+
+    void append(const KeybindItem &item);
+    void append(const QList<KeybindItem> &items);
+
+    // Interned text of one field
+    const QString &text(int index, Column column) const;
+
+    // String id of one field; equal ids mean equal text
+    quint32 stringId(int index, Column column) const;
+
+    // Interned string by id, and the number of distinct strings
+    const QString &string(quint32 id) const;
+    int stringCount() const;
+
+    // Copy of one item, for code that still works with KeybindItem
+    KeybindItem item(int index) const;
+
+    // Approximate heap usage of the store in bytes: the interned strings
+    // with their lookup hash, and the per-column id vectors
+    qint64 memoryUsage() const;
+    qint64 stringBytes() const;
+    qint64 columnBytes() const;
+
+private:
+    quint32 intern(const QString &text);
+
+    QList<QString> m_strings;           // Id -> string, id 0 is the empty string
+    QHash<QString, quint32> m_ids;      // String -> id
+    std::vector<quint32> m_columns[ColumnCount];
+};
+
+#endif // KEYBINDSTORE_H
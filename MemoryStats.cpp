@@ -0,0 +1,159 @@
+#include "MemoryStats.h"
+#include "KeybindModel.h"
+#include <QFile>
+
+namespace {
+
+// Whole file, or empty if it cannot be read (not Linux, or no /proc)
+QByteArray readAll(const char *path)
+{
+    QFile file(QString::fromLatin1(path));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    // procfs files report a size of 0, so read until the end
+    return file.readAll();
+}
+
+} // namespace
+
+// Constructor
+MemoryStats::MemoryStats(QObject *parent)
+    : QObject(parent)
+    , m_model(nullptr)
+    , m_liveDelegates(0)
+{
+}
+
+MemoryStats::Process MemoryStats::readProcess()
+{
+    Process process;
+    parseProcFile(readAll("/proc/self/smaps_rollup"), &process);
+
+    // Peak RSS is only in status; so are RSS and swap on kernels before
+    // 4.14, which have no smaps_rollup
+    parseProcFile(readAll("/proc/self/status"), &process);
+    return process;
+}
+
+void MemoryStats::parseProcFile(const QByteArray &data, Process *process)
+{
+    for (const QByteArray &line : data.split('\n')) {
+        const int colon = line.indexOf(':');
+        if (colon <= 0) {
+            continue;
+        }
+        const QByteArray name = line.left(colon);
+        QByteArray value = line.mid(colon + 1).trimmed();
+        if (!value.endsWith(" kB")) {
+            continue;
+        }
+        value.chop(3);
+        bool ok = false;
+        const qint64 bytes = value.trimmed().toLongLong(&ok) * 1024;
+        if (!ok) {
+            continue;
+        }
+
+        if (name == "Rss" || (name == "VmRSS" && process->rss < 0)) {
+            process->rss = bytes;
+        } else if (name == "Pss") {
+            process->pss = bytes;
+        } else if (name == "Private_Clean" || name == "Private_Dirty") {
+            process->privateBytes = qMax<qint64>(process->privateBytes, 0) + bytes;
+        } else if (name == "Swap" || (name == "VmSwap" && process->swap < 0)) {
+            process->swap = bytes;
+        } else if (name == "VmHWM") {
+            process->peakRss = bytes;
+        }
+    }
+}
+
+QString MemoryStats::formatBytes(qint64 bytes)
+{
+    if (bytes < 0) {
+        return QStringLiteral("n/a");
+    }
+    if (bytes < 1024) {
+        return QString::number(bytes) + " B";
+    }
+    if (bytes < 1024 * 1024) {
+        return QString::number(double(bytes) / 1024.0, 'f', 1) + " KiB";
+    }
+    return QString::number(double(bytes) / (1024.0 * 1024.0), 'f', 1) + " MiB";
+}
+
+void MemoryStats::setModel(const KeybindModel *model)
+{
+    m_model = model;
+}
+
+void MemoryStats::addCounter(const QString &name, const std::function<qint64()> &bytes)
+{
+    m_counters.append(qMakePair(name, bytes));
+}
+
+void MemoryStats::delegateCreated()
+{
+    ++m_liveDelegates;
+}
+
+void MemoryStats::delegateDestroyed()
+{
+    --m_liveDelegates;
+}
+
+int MemoryStats::liveDelegates() const
+{
+    return m_liveDelegates;
+}
+
+QList<MemoryStats::Line> MemoryStats::lines() const
+{
+    QList<Line> result;
+
+    const Process process = readProcess();
+    result.append({ "RSS", process.rss, true });
+    result.append({ "PSS", process.pss, true });
+    result.append({ "private", process.privateBytes, true });
+    result.append({ "swap", process.swap, true });
+    result.append({ "peak RSS", process.peakRss, true });
+
+    if (m_model) {
+        const KeybindModel::MemoryUsage usage = m_model->memoryUsage();
+        result.append({ "model strings", usage.strings, true });
+        result.append({ "model columns", usage.columns, true });
+        result.append({ "filtered indices", usage.filtered, true });
+        result.append({ "visible rows", usage.visibleRows, true });
+        result.append({ "search index", usage.searchIndex, true });
+        result.append({ "fuzzy matcher", usage.fuzzyMatcher, true });
+        result.append({ "chord index", usage.chordIndex, true });
+        result.append({ "sort index", usage.sortIndex, true });
+    }
+
+    for (const auto &counter : m_counters) {
+        result.append({ counter.first, counter.second(), true });
+    }
+
+    result.append({ "live delegates", m_liveDelegates, false });
+    return result;
+}
+
+QVariantMap MemoryStats::snapshot() const
+{
+    QVariantMap map;
+    for (const Line &line : lines()) {
+        map.insert(line.name, line.value);
+    }
+    return map;
+}
+
+QString MemoryStats::report() const
+{
+    QString text;
+    for (const Line &line : lines()) {
+        const QString value = line.bytes ? formatBytes(line.value) : QString::number(line.value);
+        text += line.name.leftJustified(18) + value.rightJustified(12) + '\n';
+    }
+    return text;
+}
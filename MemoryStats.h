@@ -0,0 +1,76 @@
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVariantMap>
+#include <functional>
+
+class KeybindModel;
+
+// Memory accounting for --memstats and the debug overlay.
+//
+// Puts the process view from /proc/self/smaps_rollup (RSS, PSS, private
+// and swapped bytes) and the peak RSS from /proc/self/status next to what
+// each subsystem reports about itself: the keybind model's strings, columns
+// and indexes, the number of live list delegates and the counters added
+// with addCounter(), such as the icon cache and the theme. Subsystem figures
+// are estimated from container capacities; the rest of RSS is Qt, the QML
+// engine, the scene graph and the allocator.
+class MemoryStats : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Process figures in bytes, -1 where the kernel does not report them
+    struct Process {
+        qint64 rss = -1;
+        qint64 pss = -1;
+        qint64 privateBytes = -1;
+        qint64 swap = -1;
+        qint64 peakRss = -1;
+    };
+
+    explicit MemoryStats(QObject *parent = nullptr);
+
+    static Process readProcess();
+
+    // Add the "Name:   1234 kB" lines of smaps_rollup or status to process
+    static void parseProcFile(const QByteArray &data, Process *process);
+
+    static QString formatBytes(qint64 bytes);
+
+    void setModel(const KeybindModel *model);
+
+    // Report bytes() under name; called on every snapshot
+    void addCounter(const QString &name, const std::function<qint64()> &bytes);
+
+    // List delegates call these from Component.onCompleted/onDestruction;
+    // pooled delegates stay alive and are counted
+    Q_INVOKABLE void delegateCreated();
+    Q_INVOKABLE void delegateDestroyed();
+    int liveDelegates() const;
+
+    // Every figure by name; sizes in bytes, "live delegates" as a count
+    Q_INVOKABLE QVariantMap snapshot() const;
+
+    // snapshot() as an aligned table, for stdout and the overlay
+    Q_INVOKABLE QString report() const;
+
+private:
+    struct Line {
+        QString name;
+        qint64 value;
+        bool bytes;
+    };
+    QList<Line> lines() const;
+
+    const KeybindModel *m_model;
+    QList<QPair<QString, std::function<qint64()>>> m_counters;
+    int m_liveDelegates;
+};
+
+#endif // MEMORYSTATS_H
@@ -0,0 +1,155 @@
+#include "QueryCli.h"
+#include "KeybindLoader.h"
+#include "KeybindModel.h"
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Value of "--name=value" or "--name value", or fallback if absent
+QString optionValue(int argc, char *argv[], const char *name, const QString &fallback = QString())
+{
+    const size_t length = std::strlen(name);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], name, length) != 0)
+            continue;
+        if (argv[i][length] == '=')
+            return QString::fromLocal8Bit(argv[i] + length + 1);
+        if (argv[i][length] == '\0' && i + 1 < argc)
+            return QString::fromLocal8Bit(argv[i + 1]);
+    }
+    return fallback;
+}
+
+bool hasFlag(int argc, char *argv[], const char *name)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Tabs and newlines would break the columns
+QByteArray tsvField(const QString &text)
+{
+    QByteArray field = text.toUtf8();
+    field.replace('\t', ' ');
+    field.replace('\n', ' ');
+    field.replace('\r', ' ');
+    return field;
+}
+
+} // namespace
+
+int QueryCli::run(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fredon-modal-cheat");
+    QCoreApplication::setOrganizationName("fredon");
+
+    // stdout carries the results; keep the parser's chatter off stderr too
+    QLoggingCategory::setFilterRules(QStringLiteral("default.debug=false"));
+
+    const QString format = optionValue(argc, argv, "--format", "json");
+    if (format != "json" && format != "tsv") {
+        std::fprintf(stderr, "Unknown --format: %s (expected json or tsv)\n", qPrintable(format));
+        return 2;
+    }
+    bool limitOk = true;
+    const QString limitText = optionValue(argc, argv, "--limit");
+    const int limit = limitText.isEmpty() ? -1 : limitText.toInt(&limitOk);
+    if (!limitOk || limit < -1) {
+        std::fprintf(stderr, "Invalid --limit: %s\n", qPrintable(limitText));
+        return 2;
+    }
+
+    // Load synchronously on this thread: a warm cache is a single mmap
+    KeybindLoader loader;
+    const QString configPath = optionValue(argc, argv, "--config");
+    if (!configPath.isEmpty()) {
+        loader.setConfigPath(QFileInfo(configPath).absoluteFilePath());
+    }
+    if (hasFlag(argc, argv, "--no-ipc")) {
+        loader.setIpcSocketPath(QString());
+    } else if (!optionValue(argc, argv, "--ipc-socket").isEmpty()) {
+        loader.setIpcSocketPath(optionValue(argc, argv, "--ipc-socket"));
+    }
+    QList<KeybindItem> items;
+    QObject::connect(&loader, &KeybindLoader::batchReady, [&items](quint64, const QList<KeybindItem> &batch) {
+        items.append(batch);
+    });
+    KeybindFilter::IndexesPtr indexes;
+    QObject::connect(&loader, &KeybindLoader::finished,
+                     [&indexes](quint64, bool, const QStringList &, const KeybindFilter::IndexesPtr &built) {
+        indexes = built;
+    });
+    loader.load(0);
+
+    // Same filtering and ranking as the popup
+    KeybindModel model;
+    model.setFuzzyMatching(!hasFlag(argc, argv, "--no-fuzzy"));
+    model.setKeybinds(items, indexes);
+    model.setFilterText(optionValue(argc, argv, "--filter"));
+    model.refresh();
+
+    const int count = limit < 0 ? model.filteredCount() : qMin(limit, model.filteredCount());
+    const bool json = format == "json";
+
+    // Write in chunks so large lists stream instead of piling up
+    QByteArray out;
+    out.reserve(64 * 1024);
+    if (json) {
+        out += '[';
+    }
+    for (int i = 0; i < count; ++i) {
+        if (json) {
+            writeJson(model.filteredKeybind(i), i == 0, &out);
+        } else {
+            writeTsv(model.filteredKeybind(i), &out);
+        }
+        if (out.size() >= 60 * 1024) {
+            std::fwrite(out.constData(), 1, size_t(out.size()), stdout);
+            out.clear();
+        }
+    }
+    if (json) {
+        out += "]\n";
+    }
+    std::fwrite(out.constData(), 1, size_t(out.size()), stdout);
+    std::fflush(stdout);
+    return 0;
+}
+
+void QueryCli::writeJson(const KeybindItem &item, bool first, QByteArray *out)
+{
+    QJsonObject object;
+    object["name"] = item.name;
+    object["keybind"] = item.keybind;
+    object["description"] = item.description;
+    object["icon"] = item.icon;
+    object["dispatcher"] = item.dispatcher;
+    if (!first) {
+        *out += ',';
+    }
+    *out += QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+void QueryCli::writeTsv(const KeybindItem &item, QByteArray *out)
+{
+    *out += tsvField(item.name);
+    *out += '\t';
+    *out += tsvField(item.keybind);
+    *out += '\t';
+    *out += tsvField(item.description);
+    *out += '\t';
+    *out += tsvField(item.icon);
+    *out += '\t';
+    *out += tsvField(item.dispatcher);
+    *out += '\n';
+}
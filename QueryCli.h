@@ -0,0 +1,29 @@
+#ifndef QUERYCLI_H
+#define QUERYCLI_H
+
+#include <QByteArray>
+#include "KeybindItem.h"
+
+// Headless "--list" mode for pickers and status bars.
+//
+// Runs on a plain QCoreApplication: no GUI application, QML engine or
+// display connection is created. The keybinds come from the same loader
+// (binary cache first, parser on a miss) and go through KeybindModel's
+// filter, then are written to stdout:
+//
+//   --list [--format=json|tsv] [--filter=<query>] [--limit=<n>]
+//          [--no-fuzzy] [--config=<file>]
+class QueryCli
+{
+public:
+    // Entry point used by main(); returns the process exit code
+    static int run(int argc, char *argv[]);
+
+private:
+    static void writeJson(const KeybindItem &item, bool first, QByteArray *out);
+    // Columns: name, keybind, description, icon, dispatcher; the same
+    // fields as the JSON objects, new ones appended so cut -f stays valid
+    static void writeTsv(const KeybindItem &item, QByteArray *out);
+};
+
+#endif // QUERYCLI_H
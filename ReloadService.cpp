@@ -0,0 +1,138 @@
+#include "ReloadService.h"
+#include <QFileInfo>
+#include <QDebug>
+
+// Constructor
+ReloadService::ReloadService(QObject *parent)
+    : QObject(parent)
+{
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(DebounceMs);
+
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &ReloadService::handleFileChanged);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ReloadService::handleDirectoryChanged);
+    connect(&m_debounce, &QTimer::timeout, this, &ReloadService::flush);
+}
+
+void ReloadService::setKeybindFiles(const QStringList &paths)
+{
+    m_keybindFiles = paths;
+    m_keybindFiles.removeDuplicates();
+    for (const QString &path : std::as_const(m_keybindFiles)) {
+        track(path);
+    }
+    updateWatches();
+}
+
+void ReloadService::setThemeFile(const QString &path)
+{
+    // Embedded themes cannot change, so there is nothing to watch
+    m_themeFile = path.isEmpty() || path.startsWith(':') ? QString() : QFileInfo(path).absoluteFilePath();
+    if (!m_themeFile.isEmpty()) {
+        track(m_themeFile);
+    }
+    updateWatches();
+}
+
+// Remember the current state of path so later events can be compared to it
+void ReloadService::track(const QString &path)
+{
+    m_stamps.insert(path, FileStamp::fromPath(path));
+}
+
+// Watch every tracked path that exists, and the directories they live in
+void ReloadService::updateWatches()
+{
+    QStringList paths = m_keybindFiles;
+    if (!m_themeFile.isEmpty()) {
+        paths.append(m_themeFile);
+    }
+
+    // Forget paths that are no longer of interest
+    for (auto it = m_stamps.begin(); it != m_stamps.end();) {
+        if (paths.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_stamps.erase(it);
+        }
+    }
+
+    QSet<QString> wanted;
+    for (const QString &path : std::as_const(paths)) {
+        QFileInfo info(path);
+        if (info.exists()) {
+            wanted.insert(path);
+        }
+        if (!info.isDir()) {
+            wanted.insert(info.absolutePath());
+        }
+    }
+
+    const QStringList watched = m_watcher.files() + m_watcher.directories();
+    for (const QString &path : watched) {
+        if (!wanted.contains(path)) {
+            m_watcher.removePath(path);
+        }
+    }
+    for (const QString &path : std::as_const(wanted)) {
+        if (!watched.contains(path)) {
+            m_watcher.addPath(path);
+        }
+    }
+}
+
+void ReloadService::handleFileChanged(const QString &path)
+{
+    m_candidates.insert(path);
+    m_debounce.start();
+}
+
+// A file was created, removed or renamed in a watched directory
+void ReloadService::handleDirectoryChanged(const QString &path)
+{
+    for (auto it = m_stamps.cbegin(); it != m_stamps.cend(); ++it) {
+        if (it.key() == path || QFileInfo(it.key()).absolutePath() == path) {
+            m_candidates.insert(it.key());
+        }
+    }
+    m_debounce.start();
+}
+
+// Report the paths whose stat actually changed since the last report
+void ReloadService::flush()
+{
+    QStringList changedKeybindFiles;
+    bool themeChanged = false;
+
+    for (const QString &path : std::as_const(m_candidates)) {
+        auto it = m_stamps.find(path);
+        if (it == m_stamps.end()) {
+            continue;
+        }
+        const FileStamp stamp = FileStamp::fromPath(path);
+        if (stamp == it.value()) {
+            continue;
+        }
+        it.value() = stamp;
+
+        if (path == m_themeFile) {
+            themeChanged = true;
+        }
+        if (m_keybindFiles.contains(path)) {
+            changedKeybindFiles.append(path);
+        }
+    }
+    m_candidates.clear();
+
+    // A rename-save drops the watch on the old inode; pick up the new one
+    updateWatches();
+
+    if (!changedKeybindFiles.isEmpty()) {
+        qDebug() << "Keybind files changed:" << changedKeybindFiles;
+        emit keybindFilesChanged(changedKeybindFiles);
+    }
+    if (themeChanged) {
+        qDebug() << "Theme file changed:" << m_themeFile;
+        emit themeFileChanged(m_themeFile);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef RELOADSERVICE_H
+#define RELOADSERVICE_H
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include "FileStamp.h"
+
+// Watches the keybind config files and the theme file and reports changes.
+//
+// Every file's parent directory is watched as well: editors that save by
+// writing a temporary file and renaming it over the original replace the
+// inode, which silently drops a plain file watch. Events are collected for
+// DebounceMs and then checked against the file's last stat, so a burst of
+// writes (or an attribute-only touch) produces at most one notification.
+class ReloadService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int DebounceMs = 150;
+
+    explicit ReloadService(QObject *parent = nullptr);
+
+    // Config files and globbed directories the keybinds were read from
+    void setKeybindFiles(const QStringList &paths);
+
+    // Theme JSON currently in use; empty to stop watching
+    void setThemeFile(const QString &path);
+
+signals:
+    void keybindFilesChanged(const QStringList &paths);
+    void themeFileChanged(const QString &path);
+
+private slots:
+    void handleFileChanged(const QString &path);
+    void handleDirectoryChanged(const QString &path);
+    void flush();
+
+private:
+    void track(const QString &path);
+    void updateWatches();
+
+    QFileSystemWatcher m_watcher;
+    QTimer m_debounce;
+    QStringList m_keybindFiles;
+    QString m_themeFile;
+    QHash<QString, FileStamp> m_stamps;     // Last seen state of every tracked path
+    QSet<QString> m_candidates;             // Paths that may have changed since the last flush
+};
+
+#endif // RELOADSERVICE_H
@@ -0,0 +1,146 @@
+#include "StartupTrace.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <QDebug>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char *name;
+    qint64 startNs;
+    qint64 durationNs;      // -1 for instant events
+    quintptr thread;
+};
+
+QElapsedTimer s_clock;
+std::atomic<bool> s_enabled(false);
+QMutex s_mutex;
+std::vector<TraceEvent> s_events;
+QString s_outputPath;
+
+void record(const char *name, qint64 startNs, qint64 durationNs)
+{
+    const TraceEvent event = { name, startNs, durationNs, quintptr(QThread::currentThreadId()) };
+    QMutexLocker locker(&s_mutex);
+    if (s_enabled.load(std::memory_order_relaxed)) {
+        s_events.push_back(event);
+    }
+}
+
+} // namespace
+
+StartupTrace::Scope::Scope(const char *name)
+    : m_name(name)
+    , m_start(StartupTrace::isEnabled() ? StartupTrace::now() : -1)
+{
+}
+
+StartupTrace::Scope::~Scope()
+{
+    if (m_start >= 0) {
+        StartupTrace::complete(m_name, m_start);
+    }
+}
+
+void StartupTrace::start()
+{
+    s_clock.start();
+}
+
+void StartupTrace::enable(const QString &outputPath)
+{
+    QMutexLocker locker(&s_mutex);
+    s_outputPath = outputPath;
+    s_events.reserve(64);
+    s_enabled.store(true, std::memory_order_release);
+}
+
+bool StartupTrace::isEnabled()
+{
+    return s_enabled.load(std::memory_order_acquire);
+}
+
+qint64 StartupTrace::now()
+{
+    return s_clock.nsecsElapsed();
+}
+
+void StartupTrace::complete(const char *name, qint64 startNs)
+{
+    if (isEnabled()) {
+        record(name, startNs, now() - startNs);
+    }
+}
+
+void StartupTrace::instant(const char *name)
+{
+    if (isEnabled()) {
+        record(name, now(), -1);
+    }
+}
+
+bool StartupTrace::finish()
+{
+    std::vector<TraceEvent> events;
+    QString outputPath;
+    {
+        QMutexLocker locker(&s_mutex);
+        if (!s_enabled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        s_enabled.store(false, std::memory_order_release);
+        events.swap(s_events);
+        outputPath = s_outputPath;
+    }
+
+    // Chrome trace event format; timestamps are in microseconds
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    for (const TraceEvent &event : events) {
+        QJsonObject object;
+        object["name"] = QString::fromLatin1(event.name);
+        object["cat"] = "startup";
+        object["ts"] = double(event.startNs) / 1000.0;
+        object["pid"] = pid;
+        object["tid"] = qint64(event.thread);
+        if (event.durationNs >= 0) {
+            object["ph"] = "X";
+            object["dur"] = double(event.durationNs) / 1000.0;
+        } else {
+            object["ph"] = "i";
+            object["s"] = "p";
+        }
+        traceEvents.append(object);
+    }
+
+    QJsonObject otherData;
+    otherData["application"] = QCoreApplication::applicationName();
+    otherData["version"] = QCoreApplication::applicationVersion();
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+    root["otherData"] = otherData;
+
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not write startup trace:" << outputPath;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qWarning() << "Could not write startup trace:" << outputPath;
+        return false;
+    }
+
+    qDebug() << "Startup trace written to" << outputPath;
+    return true;
+}
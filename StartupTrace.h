@@ -0,0 +1,50 @@
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QString>
+
+// Records how long the phases of a launch take, from any thread, and writes
+// them as a Chrome trace (chrome://tracing, Perfetto) once startup is done.
+//
+// Tracing is off unless enable() was called, so the hooks cost one atomic
+// load on every other launch. Timestamps come from a monotonic clock and
+// are relative to the start of main().
+class StartupTrace
+{
+public:
+    // Marks a phase from construction to destruction
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *m_name;
+        qint64 m_start;
+    };
+
+    // Start the clock; call first thing in main()
+    static void start();
+
+    // Record events and write them to outputPath when finish() is called
+    static void enable(const QString &outputPath);
+    static bool isEnabled();
+
+    // Nanoseconds since start()
+    static qint64 now();
+
+    // A phase that began at startNs and ends now
+    static void complete(const char *name, qint64 startNs);
+
+    // A point in time, e.g. the first frame
+    static void instant(const char *name);
+
+    // Write the trace and stop recording; later calls do nothing
+    static bool finish();
+};
+
+#endif // STARTUPTRACE_H
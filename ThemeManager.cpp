@@ -1,4 +1,5 @@
 #include "ThemeManager.h"
+#include "StartupTrace.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QDir>
@@ -7,14 +8,21 @@
 #include <QDebug>
 #include <QSettings>
 
+namespace {
+
+const QString EmbeddedThemePath = QStringLiteral(":/themes/themes.json");
+
+} // namespace
+
 ThemeManager::ThemeManager(QObject *parent)
     : QObject(parent)
-    , m_currentThemeHash(QString())
+    , m_registry(new ThemeRegistry(this))
+    , m_themeHash(0)
+    , m_themeStatePersisted(false)
 {
-    // Check for theme changes first
-    detectThemeChanges();
-    
-    // Load default theme
+    connect(m_registry, &ThemeRegistry::changed, this, &ThemeManager::availableThemesChanged);
+
+    // Load default theme; the file is read once and fingerprinted from the same bytes
     loadDefaultTheme();
 }
 
@@ -30,12 +38,26 @@ void ThemeManager::loadDefaultTheme()
     // Try to load from current directory
     QString localThemePath = "themes/themes.json";
     
-    if (QFile::exists(appThemePath)) {
-        loadThemeFromFile(appThemePath);
-    } else if (QFile::exists(localThemePath)) {
-        loadThemeFromFile(localThemePath);
+    QString foundPath;
+    {
+        StartupTrace::Scope trace("theme discovery");
+        if (QFile::exists(appThemePath)) {
+            foundPath = appThemePath;
+        } else if (QFile::exists(localThemePath)) {
+            foundPath = localThemePath;
+        } else if (QFile::exists(EmbeddedThemePath)) {
+            // Built into the binary, so a plain install needs no themes directory
+            foundPath = EmbeddedThemePath;
+        }
+    }
+
+    if (!foundPath.isEmpty()) {
+        loadThemeFromFile(foundPath);
     } else {
         // Fallback to hardcoded default theme
+        m_currentThemePath.clear();
+        m_themeStamp = FileStamp();
+        m_themeHash = 0;
         m_primaryColor = QColor("#ffffff");
         m_secondaryColor = QColor("#89b4fa");
         m_backgroundColor = QColor("#000000");
@@ -85,34 +107,25 @@ QColor ThemeManager::errorColor() const
 
 bool ThemeManager::loadTheme(const QString &themeName)
 {
-    // Try to load from user directory first
-    QString userThemeDir = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + "/fredon-modal-cheat/themes/";
-    QString userThemePath = userThemeDir + themeName + ".json";
-    
-    if (QFile::exists(userThemePath)) {
-        return loadThemeFromFile(userThemePath);
-    }
-    
-    // Try to load from application directory
-    QString appThemeDir = QCoreApplication::applicationDirPath() + "/themes/";
-    QString appThemePath = appThemeDir + themeName + ".json";
-    
-    if (QFile::exists(appThemePath)) {
-        return loadThemeFromFile(appThemePath);
-    }
-    
-    // Try to load from current directory
-    QString localThemePath = "themes/" + themeName + ".json";
-    if (QFile::exists(localThemePath)) {
-        return loadThemeFromFile(localThemePath);
+    // Resolved and parsed once per theme; later switches are a lookup
+    const ThemeRegistry::Entry *entry = m_registry->theme(themeName);
+    if (!entry) {
+        qWarning() << "Theme file not found:" << themeName;
+        return false;
     }
-    
-    qWarning() << "Theme file not found:" << themeName;
-    return false;
+
+    m_themeStamp = entry->stamp;
+    m_themeHash = entry->hash;
+    m_themeStatePersisted = false;
+    applyPalette(entry->palette, entry->path);
+    return true;
 }
 
 bool ThemeManager::loadThemeFromFile(const QString &filePath)
 {
+    // Stat before reading, so a write racing with the read shows up as a change later
+    const FileStamp stamp = FileStamp::fromPath(filePath);
+
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Could not open theme file:" << filePath;
@@ -121,154 +134,120 @@ bool ThemeManager::loadThemeFromFile(const QString &filePath)
     
     QByteArray data = file.readAll();
     file.close();
-    
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (!doc.isObject()) {
+
+    if (!applyThemeData(data, filePath)) {
+        return false;
+    }
+
+    m_themeStamp = stamp;
+    m_themeHash = contentHash(data);
+    m_themeStatePersisted = false;
+    return true;
+}
+
+// Parse theme JSON and take over the colors it defines
+bool ThemeManager::applyThemeData(const QByteArray &data, const QString &filePath)
+{
+    ThemePalette palette;
+    if (!ThemePalette::fromJson(data, &palette)) {
         qWarning() << "Invalid theme file format:" << filePath;
         return false;
     }
-    
-    QJsonObject themeObj = doc.object();
-    
-    // Load colors from JSON (support both "property" and "m_property" formats for backward compatibility)
-    auto getColorValue = [&](const QString &key, const QString &mKey) -> QColor {
-        if (themeObj.contains(key) && themeObj[key].isString()) {
-            return QColor(themeObj[key].toString());
-        } else if (themeObj.contains(mKey) && themeObj[mKey].isString()) {
-            return QColor(themeObj[mKey].toString());
-        }
-        return QColor(); // Return invalid color if not found
-    };
-    
-    QColor primaryColor = getColorValue("primaryColor", "m_primaryColor");
-    if (primaryColor.isValid()) m_primaryColor = primaryColor;
-    
-    QColor secondaryColor = getColorValue("secondaryColor", "m_secondaryColor");
-    if (secondaryColor.isValid()) m_secondaryColor = secondaryColor;
-    
-    QColor backgroundColor = getColorValue("backgroundColor", "m_backgroundColor");
-    if (backgroundColor.isValid()) m_backgroundColor = backgroundColor;
-    
-    QColor surfaceColor = getColorValue("surfaceColor", "m_surfaceColor");
-    if (surfaceColor.isValid()) m_surfaceColor = surfaceColor;
-    
-    QColor textColor = getColorValue("textColor", "m_textColor");
-    if (textColor.isValid()) m_textColor = textColor;
-    
-    QColor accentColor = getColorValue("accentColor", "m_accentColor");
-    if (accentColor.isValid()) m_accentColor = accentColor;
-    
-    QColor errorColor = getColorValue("errorColor", "m_errorColor");
-    if (errorColor.isValid()) m_errorColor = errorColor;
-    
-    emit themeChanged();
+
+    applyPalette(palette, filePath);
     return true;
 }
 
+// Take over the colors the palette defines; the others keep their value
+void ThemeManager::applyPalette(const ThemePalette &palette, const QString &filePath)
+{
+    if (palette.primaryColor.isValid()) m_primaryColor = palette.primaryColor;
+    if (palette.secondaryColor.isValid()) m_secondaryColor = palette.secondaryColor;
+    if (palette.backgroundColor.isValid()) m_backgroundColor = palette.backgroundColor;
+    if (palette.surfaceColor.isValid()) m_surfaceColor = palette.surfaceColor;
+    if (palette.textColor.isValid()) m_textColor = palette.textColor;
+    if (palette.accentColor.isValid()) m_accentColor = palette.accentColor;
+    if (palette.errorColor.isValid()) m_errorColor = palette.errorColor;
+
+    m_currentThemePath = filePath;
+    emit themeChanged();
+}
+
 QStringList ThemeManager::availableThemes() const
 {
-    QStringList themes;
-    
-    // Check user directory
-    QString userThemeDir = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + "/fredon-modal-cheat/themes/";
-    QDir userDir(userThemeDir);
-    if (userDir.exists()) {
-        QStringList userThemes = userDir.entryList(QStringList() << "*.json", QDir::Files);
-        for (const QString &theme : userThemes) {
-            themes.append(theme.left(theme.lastIndexOf('.')));
-        }
-    }
-    
-    // Check application directory
-    QString appThemeDir = QCoreApplication::applicationDirPath() + "/themes/";
-    QDir appDir(appThemeDir);
-    if (appDir.exists()) {
-        QStringList appThemes = appDir.entryList(QStringList() << "*.json", QDir::Files);
-        for (const QString &theme : appThemes) {
-            QString themeName = theme.left(theme.lastIndexOf('.'));
-            if (!themes.contains(themeName)) {
-                themes.append(themeName);
-            }
-        }
-    }
-    
-    // Check current directory
-    QDir localDir("themes/");
-    if (localDir.exists()) {
-        QStringList localThemes = localDir.entryList(QStringList() << "*.json", QDir::Files);
-        for (const QString &theme : localThemes) {
-            QString themeName = theme.left(theme.lastIndexOf('.'));
-            if (!themes.contains(themeName)) {
-                themes.append(themeName);
-            }
-        }
-    }
-    
-    return themes;
+    return m_registry->names();
 }
 
-QString ThemeManager::calculateThemeFileHash(const QString &filePath)
+// True if the current theme file's contents differ from what was loaded
+bool ThemeManager::detectThemeChanges()
 {
-    QFile file(filePath);
+    if (m_currentThemePath.isEmpty()) {
+        return false;
+    }
+
+    // Unchanged size, mtime and inode: no need to read the file
+    const FileStamp stamp = FileStamp::fromPath(m_currentThemePath);
+    if (stamp == m_themeStamp) {
+        return false;
+    }
+
+    QFile file(m_currentThemePath);
     if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "Could not open theme file for hashing:" << filePath;
-        return QString();
+        return false;
     }
-    
-    QByteArray fileData = file.readAll();
-    file.close();
-    
-    QCryptographicHash hash(QCryptographicHash::Sha256);
-    hash.addData(fileData);
-    return QString(hash.result().toHex());
+    const quint64 hash = contentHash(file.readAll());
+    m_themeStamp = stamp;
+
+    // Touched or rewritten with the same contents
+    if (hash == m_themeHash) {
+        return false;
+    }
+
+    m_themeHash = hash;
+    m_themeStatePersisted = false;
+    m_registry->invalidate(m_currentThemePath);
+    persistThemeState();
+    return true;
 }
 
-bool ThemeManager::detectThemeChanges()
+void ThemeManager::persistThemeState()
 {
-    // Find the themes.json file
-    QString themePath;
-    
-    // Try to load from application directory
-    QString appThemeDir = QCoreApplication::applicationDirPath() + "/themes/";
-    QString appThemePath = appThemeDir + "themes.json";
-    
-    // Try to load from current directory
-    QString localThemePath = "themes/themes.json";
-    
-    if (QFile::exists(appThemePath)) {
-        themePath = appThemePath;
-    } else if (QFile::exists(localThemePath)) {
-        themePath = localThemePath;
-    } else {
-        // No theme file found
-        return false;
+    if (m_themeStatePersisted || m_currentThemePath.isEmpty()) {
+        return;
     }
-    
-    // Calculate current theme hash
-    QString currentHash = calculateThemeFileHash(themePath);
-    
-    // Get stored hash from settings
+    m_themeStatePersisted = true;
+
+    const QString hash = QString::number(m_themeHash, 16);
     QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
-    QString storedHash = settings.value("theme/hash").toString();
-    
-    // Store current hash for next comparison
-    m_currentThemeHash = currentHash;
-    
-    // If hashes differ, theme has changed
-    if (!storedHash.isEmpty() && currentHash != storedHash) {
-        // Save new hash
-        settings.setValue("theme/hash", currentHash);
-        settings.sync();
-        return true;
+    if (settings.value("theme/hash").toString() != hash) {
+        settings.setValue("theme/hash", hash);
     }
-    
-    // Save current hash if not already stored
-    if (storedHash.isEmpty()) {
-        settings.setValue("theme/hash", currentHash);
-        settings.sync();
+}
+
+// Re-read the current theme file, e.g. after it was edited on disk
+bool ThemeManager::reloadTheme()
+{
+    if (m_currentThemePath.isEmpty() || !QFile::exists(m_currentThemePath)) {
+        loadDefaultTheme();
+        persistThemeState();
+        return !m_currentThemePath.isEmpty();
     }
-    
-    return false;
+
+    m_registry->invalidate(m_currentThemePath);
+    const bool loaded = loadThemeFromFile(m_currentThemePath);
+    persistThemeState();
+    return loaded;
+}
+
+QString ThemeManager::currentThemePath() const
+{
+    return m_currentThemePath;
+}
+
+qint64 ThemeManager::memoryUsage() const
+{
+    return qint64(m_currentThemePath.capacity() + m_themeStamp.path.capacity()) * qint64(sizeof(QChar))
+         + m_registry->memoryUsage();
 }
 
 bool ThemeManager::checkForThemeChanges()
@@ -8,8 +8,9 @@
 #include <QFile>
 #include <QStandardPaths>
 #include <QDebug>
-#include <QCryptographicHash>
 #include <QSettings>
+#include "FileStamp.h"
+#include "ThemeRegistry.h"
 
 class ThemeManager : public QObject
 {
@@ -38,15 +39,30 @@ public:
     Q_INVOKABLE bool loadTheme(const QString &themeName);
     Q_INVOKABLE QStringList availableThemes() const;
     Q_INVOKABLE bool checkForThemeChanges();
+    Q_INVOKABLE bool reloadTheme();
+
+    // Persist the fingerprint of the current theme file. Kept off the
+    // startup path; main() calls it once the first frame is on screen.
+    Q_INVOKABLE void persistThemeState();
+
+    // Load colors from a theme file at an explicit path
+    bool loadThemeFromFile(const QString &filePath);
+
+    // Theme file the current colors came from; empty for the built-in theme
+    QString currentThemePath() const;
+
+    // Approximate heap usage of the theme state and registry in bytes
+    qint64 memoryUsage() const;
 
 signals:
     void themeChanged();
     void themeFileChanged(); // Signal emitted when theme file changes are detected
+    void availableThemesChanged();
 
 private:
     void loadDefaultTheme();
-    bool loadThemeFromFile(const QString &filePath);
-    QString calculateThemeFileHash(const QString &filePath);
+    bool applyThemeData(const QByteArray &data, const QString &filePath);
+    void applyPalette(const ThemePalette &palette, const QString &filePath);
     bool detectThemeChanges();
     
     // Theme colors
@@ -58,8 +74,14 @@ private:
     QColor m_accentColor;
     QColor m_errorColor;
     
-    // Theme file tracking
-    QString m_currentThemeHash;
+    // Installed themes, listed and parsed once
+    ThemeRegistry *m_registry;
+
+    // Theme file tracking: a stat decides whether the file needs hashing
+    QString m_currentThemePath;
+    FileStamp m_themeStamp;
+    quint64 m_themeHash;
+    bool m_themeStatePersisted;
 };
 
 #endif // THEMEMANAGER_H
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "ThemeRegistry.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QDebug>
+
+bool ThemePalette::fromJson(const QByteArray &data, ThemePalette *palette)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject()) {
+        return false;
+    }
+
+    QJsonObject themeObj = doc.object();
+
+    // Support both "property" and "m_property" formats for backward compatibility
+    auto getColorValue = [&](const QString &key, const QString &mKey) -> QColor {
+        if (themeObj.contains(key) && themeObj[key].isString()) {
+            return QColor(themeObj[key].toString());
+        } else if (themeObj.contains(mKey) && themeObj[mKey].isString()) {
+            return QColor(themeObj[mKey].toString());
+        }
+        return QColor(); // Return invalid color if not found
+    };
+
+    palette->primaryColor = getColorValue("primaryColor", "m_primaryColor");
+    palette->secondaryColor = getColorValue("secondaryColor", "m_secondaryColor");
+    palette->backgroundColor = getColorValue("backgroundColor", "m_backgroundColor");
+    palette->surfaceColor = getColorValue("surfaceColor", "m_surfaceColor");
+    palette->textColor = getColorValue("textColor", "m_textColor");
+    palette->accentColor = getColorValue("accentColor", "m_accentColor");
+    palette->errorColor = getColorValue("errorColor", "m_errorColor");
+    return true;
+}
+
+// Constructor
+ThemeRegistry::ThemeRegistry(QObject *parent)
+    : QObject(parent)
+    , m_scanned(false)
+{
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ThemeRegistry::handleDirectoryChanged);
+}
+
+QStringList ThemeRegistry::searchDirs()
+{
+    return {
+        QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + "/fredon-modal-cheat/themes",
+        QCoreApplication::applicationDirPath() + "/themes",
+        QDir::current().absoluteFilePath("themes"),
+        QStringLiteral(":/themes")
+    };
+}
+
+QStringList ThemeRegistry::names()
+{
+    scan();
+    return m_names;
+}
+
+const ThemeRegistry::Entry *ThemeRegistry::theme(const QString &name)
+{
+    scan();
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+        return nullptr;
+    }
+
+    Entry &entry = it.value();
+    if (!entry.parsed) {
+        entry.parsed = true;
+        entry.stamp = FileStamp::fromPath(entry.path);
+
+        QFile file(entry.path);
+        if (file.open(QIODevice::ReadOnly)) {
+            const QByteArray data = file.readAll();
+            entry.hash = contentHash(data);
+            entry.valid = ThemePalette::fromJson(data, &entry.palette);
+        }
+        if (!entry.valid) {
+            qWarning() << "Invalid theme file:" << entry.path;
+        }
+    }
+    return entry.valid ? &entry : nullptr;
+}
+
+void ThemeRegistry::invalidate(const QString &path)
+{
+    const QString absolutePath = QFileInfo(path).absoluteFilePath();
+    for (Entry &entry : m_entries) {
+        if (entry.path == absolutePath) {
+            entry.parsed = false;
+            entry.valid = false;
+        }
+    }
+}
+
+qint64 ThemeRegistry::memoryUsage() const
+{
+    qint64 bytes = qint64(m_names.capacity()) * qint64(sizeof(QString));
+    for (const QString &name : m_names) {
+        bytes += qint64(name.capacity()) * qint64(sizeof(QChar));
+    }
+    bytes += qint64(m_entries.capacity()) * qint64(sizeof(QString) + sizeof(Entry) + sizeof(void *));
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        bytes += qint64(it.key().capacity() + it->path.capacity() + it->stamp.path.capacity()) * qint64(sizeof(QChar));
+    }
+    return bytes;
+}
+
+// A theme directory (or the parent it is expected in) changed
+void ThemeRegistry::handleDirectoryChanged()
+{
+    m_scanned = false;
+    m_names.clear();
+    m_entries.clear();
+    emit changed();
+}
+
+// List every theme directory once and watch it for changes
+void ThemeRegistry::scan()
+{
+    if (m_scanned) {
+        return;
+    }
+    m_scanned = true;
+
+    QStringList watched;
+    for (const QString &dirPath : searchDirs()) {
+        QDir dir(dirPath);
+        const QStringList files = dir.entryList(QStringList() << "*.json", QDir::Files);
+        for (const QString &fileName : files) {
+            const QString name = fileName.left(fileName.lastIndexOf('.'));
+            if (m_entries.contains(name)) {
+                continue;
+            }
+            Entry entry;
+            entry.path = dir.absoluteFilePath(fileName);
+            m_entries.insert(name, entry);
+            m_names.append(name);
+        }
+
+        // Embedded themes never change
+        if (dirPath.startsWith(':')) {
+            continue;
+        }
+
+        // A directory that does not exist yet is picked up through its parent
+        QFileInfo info(dirPath);
+        while (!info.exists() && !info.isRoot()) {
+            info.setFile(info.absolutePath());
+        }
+        if (!watched.contains(info.absoluteFilePath())) {
+            watched.append(info.absoluteFilePath());
+        }
+    }
+
+    const QStringList current = m_watcher.directories();
+    if (!current.isEmpty()) {
+        m_watcher.removePaths(current);
+    }
+    m_watcher.addPaths(watched);
+}
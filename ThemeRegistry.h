@@ -0,0 +1,81 @@
+#ifndef THEMEREGISTRY_H
+#define THEMEREGISTRY_H
+
+#include <QObject>
+#include <QColor>
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include "FileStamp.h"
+
+// Colors defined by one theme file; colors the file leaves out are invalid
+struct ThemePalette {
+    QColor primaryColor;
+    QColor secondaryColor;
+    QColor backgroundColor;
+    QColor surfaceColor;
+    QColor textColor;
+    QColor accentColor;
+    QColor errorColor;
+
+    // Parse theme JSON; accepts both "property" and "m_property" keys
+    static bool fromJson(const QByteArray &data, ThemePalette *palette);
+};
+
+// Index of the installed themes.
+//
+// The theme directories (user config, application dir, ./themes and the
+// themes embedded in the binary) are listed once, on first use. A name found
+// in several directories resolves to the first one in that order. Palettes
+// are parsed the first time a theme is loaded and kept, so switching back to
+// it is a hash lookup. Watching the directories (or their nearest existing
+// parent) drops the index when a theme is added, removed or replaced.
+class ThemeRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry {
+        QString path;
+        bool parsed = false;        // palette, stamp and hash are filled in
+        bool valid = false;         // the file could be read and parsed
+        ThemePalette palette;
+        FileStamp stamp;
+        quint64 hash = 0;
+    };
+
+    explicit ThemeRegistry(QObject *parent = nullptr);
+
+    // Directories searched for <name>.json, highest priority first
+    static QStringList searchDirs();
+
+    // Theme names in priority order, without duplicates
+    QStringList names();
+
+    // Resolved and parsed theme, or nullptr if it is unknown or invalid
+    const Entry *theme(const QString &name);
+
+    // Forget the parsed palette of path, e.g. after it was edited in place
+    void invalidate(const QString &path);
+
+    // Approximate heap usage of the index and the parsed palettes in bytes
+    qint64 memoryUsage() const;
+
+signals:
+    void changed();
+
+private slots:
+    void handleDirectoryChanged();
+
+private:
+    void scan();
+
+    QFileSystemWatcher m_watcher;
+    bool m_scanned;
+    QStringList m_names;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // THEMEREGISTRY_H
@@ -0,0 +1,86 @@
+#include "ConfigGenerator.h"
+#include <QFile>
+#include <QRandomGenerator>
+
+namespace {
+
+const char *const BindKinds[] = { "bind", "bind", "bind", "bindm", "bindel", "bindl", "bindi" };
+const char *const Modifiers[] = { "$mainMod", "$mainMod SHIFT", "$mainMod CTRL", "$mainMod ALT", "$mainMod SHIFT CTRL", "ALT", "" };
+const char *const Keys[] = { "Return", "Space", "Tab", "Escape", "Left", "Right", "Up", "Down",
+                             "XF86AudioRaiseVolume", "XF86AudioLowerVolume", "mouse:272", "mouse_down" };
+const char *const Dispatchers[] = { "killactive", "togglefloating", "fullscreen", "pseudo", "togglesplit",
+                                    "movefocus", "movewindow", "resizeactive", "cyclenext", "pin" };
+const char *const Programs[] = { "$terminal", "$browser", "$fileManager", "hyprshot", "hyprpicker", "code",
+                                 "walker", "waypaper", "wlogout", "swaync-client", "btop", "lazydocker" };
+const char *const Icons[] = { "terminal", "firefox", "folder", "camera-photo", "color-picker", "code",
+                              "system-search", "preferences-desktop-wallpaper", "system-shutdown" };
+
+template<typename T, size_t N>
+const T &pick(QRandomGenerator &random, const T (&values)[N])
+{
+    return values[random.bounded(int(N))];
+}
+
+} // namespace
+
+QByteArray ConfigGenerator::generate(int bindCount, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    QByteArray out;
+    out.reserve(qsizetype(bindCount) * 64 + 256);
+
+    out += "# Generated by ConfigGenerator\n";
+    out += "$mainMod = SUPER\n";
+    out += "$terminal = kitty\n";
+    out += "$browser = firefox --new-window\n";
+    out += "$fileManager = thunar\n\n";
+
+    for (int i = 0; i < bindCount; ++i) {
+        // Roughly one bind in four carries an icon
+        if (random.bounded(4) == 0) {
+            out += "## ICON: ";
+            out += pick(random, Icons);
+            out += '\n';
+        }
+
+        const char *modifiers = pick(random, Modifiers);
+        out += pick(random, BindKinds);
+        out += " = ";
+        out += modifiers;
+        out += ", ";
+
+        const int kind = random.bounded(10);
+        if (kind < 4) {
+            out += pick(random, Keys);
+            out += ", exec, ";
+            out += pick(random, Programs);
+            if (random.bounded(2) == 0) {
+                out += " --option-";
+                out += QByteArray::number(i);
+            }
+        } else if (kind < 7) {
+            const QByteArray workspace = QByteArray::number(1 + i % 10);
+            out += workspace.right(1);
+            out += random.bounded(2) == 0 ? ", workspace, " : ", movetoworkspace, ";
+            out += workspace;
+        } else {
+            out += pick(random, Keys);
+            out += ", ";
+            out += pick(random, Dispatchers);
+            if (random.bounded(3) == 0) {
+                out += ", l";
+            }
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+bool ConfigGenerator::writeFile(const QString &path, int bindCount, quint32 seed)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(generate(bindCount, seed)) >= 0;
+}
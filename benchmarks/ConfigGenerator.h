@@ -0,0 +1,22 @@
+#ifndef CONFIGGENERATOR_H
+#define CONFIGGENERATOR_H
+
+#include <QByteArray>
+#include <QString>
+
+// Synthetic Hyprland config for benchmarks.
+//
+// The output looks like a real bindings file: a block of $variables that
+// the binds refer to, every bind* flavour, exec commands with arguments,
+// workspace binds and "## ICON:" comments on a share of the lines. The
+// same bindCount and seed always produce the same bytes.
+class ConfigGenerator
+{
+public:
+    static QByteArray generate(int bindCount, quint32 seed = 1);
+
+    // Write generate() to path; returns false if it cannot be written
+    static bool writeFile(const QString &path, int bindCount, quint32 seed = 1);
+};
+
+#endif // CONFIGGENERATOR_H
@@ -0,0 +1,120 @@
+#include "FakeHyprlandServer.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QRandomGenerator>
+#include <iterator>
+
+namespace {
+
+const char *const Dispatchers[] = {
+    "exec", "workspace", "movetoworkspace", "togglefloating", "killactive", "movefocus", "resizeactive"
+};
+
+const char *const Programs[] = {
+    "kitty", "firefox", "hyprshot -m region", "wlogout", "btop", "code", "walker"
+};
+
+const char *const Keys[] = {
+    "Return", "Q", "E", "F", "V", "left", "right", "up", "down", "1", "2", "3", "4", "5", "Print", "space"
+};
+
+} // namespace
+
+// Constructor
+FakeHyprlandServer::FakeHyprlandServer(const QString &socketPath, const QByteArray &bindsReply)
+    : m_socketPath(socketPath)
+    , m_bindsReply(bindsReply)
+    , m_listening(false)
+{
+}
+
+FakeHyprlandServer::~FakeHyprlandServer()
+{
+    stop();
+}
+
+bool FakeHyprlandServer::listen()
+{
+    start();
+    m_ready.acquire();
+    return m_listening;
+}
+
+void FakeHyprlandServer::stop()
+{
+    if (isRunning()) {
+        quit();
+        wait();
+    }
+}
+
+void FakeHyprlandServer::run()
+{
+    QLocalServer server;
+    QLocalServer::removeServer(m_socketPath);
+    m_listening = server.listen(m_socketPath);
+    m_ready.release();
+    if (!m_listening) {
+        return;
+    }
+
+    QObject::connect(&server, &QLocalServer::newConnection, &server, [this, &server]() {
+        while (QLocalSocket *client = server.nextPendingConnection()) {
+            QObject::connect(client, &QLocalSocket::readyRead, client, [this, client]() {
+                const QByteArray request = client->readAll();
+                client->write(request == "j/binds" ? m_bindsReply : QByteArray("unknown request"));
+                client->disconnectFromServer();
+            });
+            QObject::connect(client, &QLocalSocket::disconnected, client, &QObject::deleteLater);
+        }
+    });
+
+    exec();
+    server.close();
+}
+
+QByteArray FakeHyprlandServer::generateBinds(int bindCount, quint32 seed)
+{
+    QRandomGenerator random(seed);
+    const int modmasks[] = { 64, 64 | 1, 64 | 4, 64 | 8, 8, 4 | 8 };
+
+    QJsonArray binds;
+    for (int i = 0; i < bindCount; ++i) {
+        const QString dispatcher = QLatin1String(Dispatchers[random.bounded(int(std::size(Dispatchers)))]);
+        QString arg;
+        if (dispatcher == "exec") {
+            arg = QLatin1String(Programs[random.bounded(int(std::size(Programs)))]);
+        } else if (dispatcher.contains("workspace")) {
+            arg = QString::number(random.bounded(1, 11));
+        } else if (dispatcher == "movefocus") {
+            arg = QStringLiteral("l");
+        } else if (dispatcher == "resizeactive") {
+            arg = QStringLiteral("10 0");
+        }
+
+        const bool mouse = random.bounded(20) == 0;
+        const bool described = random.bounded(4) == 0;
+
+        QJsonObject bind;
+        bind["locked"] = false;
+        bind["mouse"] = mouse;
+        bind["release"] = false;
+        bind["repeat"] = dispatcher == "resizeactive";
+        bind["longPress"] = false;
+        bind["non_consuming"] = false;
+        bind["has_description"] = described;
+        bind["modmask"] = modmasks[random.bounded(int(std::size(modmasks)))];
+        bind["submap"] = dispatcher == "resizeactive" ? QStringLiteral("resize") : QString();
+        bind["key"] = mouse ? QStringLiteral("mouse:272") : QLatin1String(Keys[random.bounded(int(std::size(Keys)))]);
+        bind["keycode"] = 0;
+        bind["catch_all"] = false;
+        bind["description"] = described ? QStringLiteral("Bind %1").arg(i) : QString();
+        bind["dispatcher"] = dispatcher;
+        bind["arg"] = arg;
+        binds.append(bind);
+    }
+    return QJsonDocument(binds).toJson(QJsonDocument::Indented);
+}
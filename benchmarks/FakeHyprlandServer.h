@@ -0,0 +1,41 @@
+#ifndef FAKEHYPRLANDSERVER_H
+#define FAKEHYPRLANDSERVER_H
+
+#include <QByteArray>
+#include <QSemaphore>
+#include <QString>
+#include <QThread>
+
+// Stand-in for Hyprland's request socket.
+//
+// Listens on a local socket from its own thread, so a client on the calling
+// thread can use blocking reads against it, and answers "j/binds" the way
+// Hyprland does: the reply, then the connection is closed. Other requests
+// get "unknown request".
+class FakeHyprlandServer : public QThread
+{
+public:
+    FakeHyprlandServer(const QString &socketPath, const QByteArray &bindsReply);
+    ~FakeHyprlandServer() override;
+
+    // Start listening; returns false if the socket could not be created
+    bool listen();
+
+    // Stop serving and remove the socket
+    void stop();
+
+    // A j/binds reply of bindCount synthetic binds: modifier combinations,
+    // submaps, bindd descriptions and mouse binds. Deterministic per seed.
+    static QByteArray generateBinds(int bindCount, quint32 seed = 1);
+
+protected:
+    void run() override;
+
+private:
+    QString m_socketPath;
+    QByteArray m_bindsReply;
+    QSemaphore m_ready;
+    bool m_listening;
+};
+
+#endif // FAKEHYPRLANDSERVER_H
@@ -0,0 +1,225 @@
+#include <benchmark/benchmark.h>
+#include <QGuiApplication>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <memory>
+#include <vector>
+#include "KeybindRowItem.h"
+
+namespace {
+
+// The list delegate before KeybindRowItem, with the theme and the model
+// roles turned into properties
+const char LegacyDelegate[] = R"(
+import QtQuick 2.15
+import QtQuick.Layouts 1.15
+
+Rectangle {
+    property int index
+    property string keybind
+    property string name
+    property string description
+    property string icon
+    property var matchRanges: ({})
+
+    function escapeHtml(text) {
+        return text.replace(/&/g, "&amp;").replace(/</g, "&lt;").replace(/>/g, "&gt;");
+    }
+
+    function highlight(text, ranges, color) {
+        if (!text || !ranges || ranges.length === 0) {
+            return escapeHtml(text || "");
+        }
+        var result = "";
+        var position = 0;
+        for (var i = 0; i + 1 < ranges.length; i += 2) {
+            var start = ranges[i];
+            var end = start + ranges[i + 1];
+            result += escapeHtml(text.substring(position, start));
+            result += "<b><font color=\"" + color + "\">" + escapeHtml(text.substring(start, end)) + "</font></b>";
+            position = end;
+        }
+        return result + escapeHtml(text.substring(position));
+    }
+
+    width: 860
+    height: 50
+    color: index % 2 === 0 ? Qt.darker("#2e3440", 1.2) : "#2e3440"
+    radius: 6
+
+    RowLayout {
+        anchors.fill: parent
+        anchors.margins: 10
+
+        Rectangle {
+            Layout.preferredWidth: 150
+            Layout.fillHeight: true
+            color: "transparent"
+
+            Row {
+                anchors.centerIn: parent
+                spacing: 8
+
+                Image {
+                    source: icon !== "" ? "image://keyicon/" + encodeURIComponent(icon) : ""
+                    sourceSize: Qt.size(20, 20)
+                    width: 20
+                    height: 20
+                    fillMode: Image.PreserveAspectFit
+                    visible: icon !== "" && status !== Image.Error
+                }
+
+                Rectangle {
+                    width: 20
+                    height: 20
+                    color: "transparent"
+                    visible: icon === ""
+
+                    Text {
+                        anchors.centerIn: parent
+                        text: "🔍"
+                        color: "#ebcb8b"
+                        font.pixelSize: 14
+                    }
+                }
+
+                Text {
+                    text: highlight(keybind, matchRanges.keybind, "#88c0d0")
+                    textFormat: Text.StyledText
+                    font.bold: true
+                    font.pixelSize: 14
+                    color: "#ebcb8b"
+                }
+            }
+        }
+
+        Text {
+            Layout.preferredWidth: 200
+            text: highlight(name, matchRanges.name, "#ebcb8b")
+            textFormat: Text.StyledText
+            font.pixelSize: 14
+            color: "#81a1c1"
+            elide: Text.ElideRight
+            Layout.alignment: Qt.AlignVCenter
+        }
+
+        Text {
+            Layout.fillWidth: true
+            text: highlight(description, matchRanges.description, "#ebcb8b")
+            textFormat: Text.StyledText
+            font.pixelSize: 14
+            color: "#eceff4"
+            wrapMode: Text.WordWrap
+            Layout.alignment: Qt.AlignVCenter
+            elide: Text.ElideRight
+        }
+    }
+}
+)";
+
+const char RowItemDelegate[] = R"(
+import QtQuick 2.15
+import HyprKeys 1.0
+
+KeybindRowItem {
+    property int index
+
+    width: 860
+    height: 50
+    color: index % 2 === 0 ? Qt.darker("#2e3440", 1.2) : "#2e3440"
+    radius: 6
+    primaryColor: "#88c0d0"
+    secondaryColor: "#81a1c1"
+    accentColor: "#ebcb8b"
+    textColor: "#eceff4"
+}
+)";
+
+// Role values of one row; every third row has matches highlighted, as
+// while searching
+QVariantMap rowProperties(int row)
+{
+    QVariantMap ranges;
+    if (row % 3 == 0) {
+        ranges["keybind"] = QVariantList{ 0, 5 };
+        ranges["name"] = QVariantList{ 0, 4 };
+        ranges["description"] = QVariantList{ 7, 4, 20, 3 };
+    }
+    return QVariantMap{
+        { "index", row },
+        { "keybind", QStringLiteral("SUPER + SHIFT + %1").arg(row % 10) },
+        { "name", QStringLiteral("movetoworkspace %1").arg(row % 10) },
+        { "description", QStringLiteral("Move the focused window to workspace %1 and follow it there, "
+                                        "keeping its floating state").arg(row % 10) },
+        { "icon", QString() },
+        { "matchRanges", ranges },
+    };
+}
+
+} // namespace
+
+// Create a page of delegates, polish and render it once, then destroy it;
+// arg 0 picks the delegate (0 for the QML one, 1 for KeybindRowItem) and
+// arg 1 the number of rows
+static void BM_CreateDelegates(benchmark::State &state)
+{
+    const bool rowItem = state.range(0) != 0;
+    const int rows = int(state.range(1));
+
+    QQuickWindow window;
+    window.resize(880, rows * 55);
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(rowItem ? RowItemDelegate : LegacyDelegate, QUrl());
+    if (component.isError()) {
+        state.SkipWithError(qPrintable(component.errorString()));
+        return;
+    }
+
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<QObject>> delegates;
+        delegates.reserve(size_t(rows));
+        for (int row = 0; row < rows; ++row) {
+            QObject *object = component.createWithInitialProperties(rowProperties(row));
+            QQuickItem *item = qobject_cast<QQuickItem *>(object);
+            item->setParentItem(window.contentItem());
+            item->setY(row * 55);
+            delegates.emplace_back(object);
+        }
+
+        // Runs polish (layouts, text shaping) and one software frame
+        benchmark::DoNotOptimize(window.grabWindow());
+
+        state.PauseTiming();
+        delegates.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetLabel(rowItem ? "KeybindRowItem" : "QML delegate");
+}
+BENCHMARK(BM_CreateDelegates)
+    ->ArgsProduct({ { 0, 1 }, { 1, 12, 100 } })
+    ->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char *argv[])
+{
+    // No display needed; the software renderer makes grabWindow() portable
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+
+    QGuiApplication app(argc, argv);
+    // The benchmark is not part of the HyprKeys module, so register by hand
+    qmlRegisterTypesAndRevisions<KeybindRowItem>("HyprKeys", 1);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include <QCoreApplication>
+#include <QDir>
+#include <QStandardPaths>
+#include <cstdio>
+#include "FakeHyprlandServer.h"
+
+// Serve a synthetic j/binds reply under a fake instance signature, so the
+// IPC source can be tried outside a Hyprland session:
+//   fake_hyprland [bind count]
+//   HYPRLAND_INSTANCE_SIGNATURE=fake hyprland-cheatsheet-popup-fredon
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const int bindCount = argc > 1 ? QByteArray(argv[1]).toInt() : 200;
+    const QString runtimeDir = qEnvironmentVariable("XDG_RUNTIME_DIR", QDir::tempPath());
+    const QString instanceDir = runtimeDir + "/hypr/fake";
+    QDir().mkpath(instanceDir);
+
+    FakeHyprlandServer server(instanceDir + "/.socket.sock", FakeHyprlandServer::generateBinds(bindCount));
+    if (!server.listen()) {
+        std::fprintf(stderr, "Could not listen on %s/.socket.sock\n", qPrintable(instanceDir));
+        return 1;
+    }
+
+    std::printf("Serving %d binds; run with HYPRLAND_INSTANCE_SIGNATURE=fake\n", bindCount);
+    std::fflush(stdout);
+    return app.exec();
+}
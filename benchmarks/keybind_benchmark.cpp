@@ -0,0 +1,449 @@
+#include <benchmark/benchmark.h>
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDir>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <map>
+#include <memory>
+#include "ChordIndex.h"
+#include "ConfigGenerator.h"
+#include "FakeHyprlandServer.h"
+#include "HyprlandIpcSource.h"
+#include "KeybindFilter.h"
+#include "KeybindModel.h"
+#include "KeybindParser.h"
+
+namespace {
+
+QTemporaryDir *s_scratch = nullptr;
+
+// Generated config files, written once per size
+QString configFile(int bindCount)
+{
+    static QHash<int, QString> files;
+    auto it = files.constFind(bindCount);
+    if (it != files.constEnd())
+        return it.value();
+
+    const QString path = s_scratch->filePath(QString("bindings-%1.conf").arg(bindCount));
+    ConfigGenerator::writeFile(path, bindCount);
+    return files.insert(bindCount, path).value();
+}
+
+// Parsed keybinds of a generated config, parsed once per size
+const QList<KeybindItem> &keybinds(int bindCount)
+{
+    static QHash<int, QList<KeybindItem>> cache;
+    auto it = cache.find(bindCount);
+    if (it == cache.end()) {
+        QList<KeybindItem> items;
+        KeybindParser parser;
+        parser.parseFile(configFile(bindCount), [&items](const KeybindItem &item) {
+            items.append(item);
+        });
+        it = cache.insert(bindCount, items);
+    }
+    return it.value();
+}
+
+// Fake Hyprland sockets serving generated binds, one per size
+std::map<int, std::unique_ptr<FakeHyprlandServer>> s_servers;
+
+QString ipcSocket(int bindCount)
+{
+    const QString path = s_scratch->filePath(QString("hypr-%1.sock").arg(bindCount));
+    std::unique_ptr<FakeHyprlandServer> &server = s_servers[bindCount];
+    if (!server) {
+        server = std::make_unique<FakeHyprlandServer>(path, FakeHyprlandServer::generateBinds(bindCount));
+        server->listen();
+    }
+    return path;
+}
+
+// Prefixes of this are the filter queries
+const QString Query = QStringLiteral("movetoworkspace");
+
+// The tokenizer before the mmap rewrite: a QTextStream over a text-mode
+// device, trimmed QString lines and QString::split(',') on the bind fields.
+// It knew neither trailing "# comments" nor quoted commas.
+ParsedConfigFile legacyTokenize(QByteArray data)
+{
+    ParsedConfigFile result;
+    result.ok = true;
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly | QIODevice::Text);
+    QTextStream in(&buffer);
+    QString lastIcon;
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+        if (line.startsWith("$")) {
+            const int equalPos = line.indexOf('=');
+            if (equalPos != -1) {
+                ConfigEntry entry;
+                entry.type = ConfigEntry::Variable;
+                entry.name = line.left(equalPos).trimmed();
+                entry.value = line.mid(equalPos + 1).trimmed();
+                result.entries.append(entry);
+            }
+            continue;
+        }
+        if (line.startsWith("## ICON:")) {
+            lastIcon = line.mid(8).trimmed();
+            continue;
+        }
+        if (line.startsWith("source") && line.mid(6).trimmed().startsWith('=')) {
+            ConfigEntry entry;
+            entry.type = ConfigEntry::Source;
+            entry.value = line.mid(line.indexOf('=') + 1).trimmed();
+            result.entries.append(entry);
+            continue;
+        }
+        if (line.startsWith("bind")) {
+            const int equalPos = line.indexOf('=');
+            if (equalPos == -1) continue;
+            const QStringList parts = line.mid(equalPos + 1).trimmed().split(',');
+            if (parts.size() < 3) continue;
+
+            ConfigEntry entry;
+            entry.type = ConfigEntry::Bind;
+            entry.name = parts[0].trimmed();
+            entry.value = parts[1].trimmed();
+            entry.dispatcher = parts[2].trimmed();
+            if (parts.size() > 3) {
+                entry.params = parts.mid(3).join(',').trimmed();
+            }
+            entry.icon = lastIcon;
+            lastIcon.clear();
+            result.entries.append(entry);
+        }
+    }
+    return result;
+}
+
+// Index of the first entry where the two tokenizations differ, or -1
+qsizetype firstDifference(const ParsedConfigFile &a, const ParsedConfigFile &b)
+{
+    const qsizetype count = qMin(a.entries.size(), b.entries.size());
+    for (qsizetype i = 0; i < count; ++i) {
+        const ConfigEntry &x = a.entries[i];
+        const ConfigEntry &y = b.entries[i];
+        if (x.type != y.type || x.name != y.name || x.value != y.value || x.dispatcher != y.dispatcher
+            || x.params != y.params || x.icon != y.icon) {
+            return i;
+        }
+    }
+    return a.entries.size() == b.entries.size() ? -1 : count;
+}
+
+// Lines where the tokenizer deliberately differs from the legacy one, with
+// the fields it must produce for them: modifiers, key, dispatcher, params
+struct TokenizerCase {
+    const char *line;
+    const char *fields[4];
+};
+
+const TokenizerCase TokenizerCases[] = {
+    // A trailing comment is cut; the legacy tokenizer kept it in the params
+    { "bind = SUPER, Q, exec, kitty # terminal", { "SUPER", "Q", "exec", "kitty" } },
+    // "##" is an escaped '#'
+    { "bind = SUPER, C, exec, notify-send ##1", { "SUPER", "C", "exec", "notify-send #1" } },
+    // A quoted comma does not start a new field
+    { "bind = SUPER, \",\", exec, kitty", { "SUPER", "\",\"", "exec", "kitty" } },
+};
+
+} // namespace
+
+static void BM_ParseFile(benchmark::State &state)
+{
+    const QString path = configFile(int(state.range(0)));
+    for (auto _ : state) {
+        KeybindParser parser;
+        int count = 0;
+        parser.parseFile(path, [&count](const KeybindItem &) {
+            ++count;
+        });
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParseFile)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_ParseDevice(benchmark::State &state)
+{
+    QByteArray data = ConfigGenerator::generate(int(state.range(0)));
+    for (auto _ : state) {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        KeybindParser parser;
+        int count = 0;
+        parser.parseDevice(&buffer, [&count](const KeybindItem &) {
+            ++count;
+        });
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_ParseDevice)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMillisecond);
+
+// Tokenizing a generated config with the legacy loop (arg 1 = 0) or
+// tokenizeData() (1), with LF or CRLF line endings (arg 2). Fails if the
+// two disagree on the generated config, which has no trailing comments or
+// quoted commas, or if tokenizeData() gets one of TokenizerCases wrong.
+static void BM_Tokenize(benchmark::State &state)
+{
+    QByteArray data = ConfigGenerator::generate(int(state.range(0)));
+    if (state.range(2)) {
+        data.replace("\n", "\r\n");
+    }
+
+    const qsizetype mismatch = firstDifference(legacyTokenize(data), KeybindParser::tokenizeData(data, QString()));
+    if (mismatch >= 0) {
+        state.SkipWithError(qPrintable(QString("Tokenizers differ at entry %1").arg(mismatch)));
+        return;
+    }
+    for (const TokenizerCase &test : TokenizerCases) {
+        const ParsedConfigFile file = KeybindParser::tokenizeData(QByteArrayView(test.line), QString());
+        const ConfigEntry *entry = file.entries.size() == 1 ? &file.entries.first() : nullptr;
+        if (!entry || entry->name != test.fields[0] || entry->value != test.fields[1]
+            || entry->dispatcher != test.fields[2] || entry->params != test.fields[3]) {
+            state.SkipWithError(qPrintable(QString("Wrong tokens for: %1").arg(test.line)));
+            return;
+        }
+    }
+
+    const bool legacy = state.range(1) == 0;
+    for (auto _ : state) {
+        if (legacy) {
+            benchmark::DoNotOptimize(legacyTokenize(data));
+        } else {
+            benchmark::DoNotOptimize(KeybindParser::tokenizeData(data, QString()));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.SetLabel(legacy ? "legacy" : "tokenizeData");
+}
+BENCHMARK(BM_Tokenize)
+    ->ArgsProduct({ { 1000, 100000 }, { 0, 1 }, { 0, 1 } })
+    ->ArgNames({ "binds", "new", "crlf" })
+    ->Unit(benchmark::kMillisecond);
+
+// Round trip to a fake compositor: connect, request j/binds, read and convert
+static void BM_IpcFetch(benchmark::State &state)
+{
+    const HyprlandIpcSource source(ipcSocket(int(state.range(0))));
+    KeybindParser parser;
+    for (auto _ : state) {
+        int count = 0;
+        source.fetch(parser, [&count](const KeybindItem &) {
+            ++count;
+        });
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IpcFetch)->RangeMultiplier(10)->Range(100, 100000)->Unit(benchmark::kMillisecond);
+
+// The JSON conversion alone, without the socket
+static void BM_IpcParse(benchmark::State &state)
+{
+    const QByteArray reply = FakeHyprlandServer::generateBinds(int(state.range(0)));
+    KeybindParser parser;
+    for (auto _ : state) {
+        int count = 0;
+        HyprlandIpcSource::parseBinds(reply, parser, [&count](const KeybindItem &) {
+            ++count;
+        });
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * reply.size());
+}
+BENCHMARK(BM_IpcParse)->RangeMultiplier(10)->Range(100, 100000)->Unit(benchmark::kMillisecond);
+
+// Filtering: args are keybind count, query length and fuzzy (1) or substring (0)
+static void BM_ApplyFilter(benchmark::State &state)
+{
+    KeybindModel model;
+    model.setFuzzyMatching(state.range(2) != 0);
+    model.setKeybinds(keybinds(int(state.range(0))));
+    const QString query = Query.left(int(state.range(1)));
+
+    for (auto _ : state) {
+        model.setFilterText(query);
+        model.refresh();
+
+        // Clear the filter so the next run cannot narrow this result
+        state.PauseTiming();
+        model.setFilterText(QString());
+        model.refresh();
+        QCoreApplication::sendPostedEvents();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ApplyFilter)
+    ->ArgsProduct({ { 1000, 100000, 1000000 }, { 1, 2, 4, 8, 15 }, { 0, 1 } })
+    ->ArgNames({ "items", "query", "fuzzy" })
+    ->Unit(benchmark::kMicrosecond);
+
+// One filter run as the filter thread does it; args are keybind count and
+// whether the run carries a live cancellation token. The two should match:
+// the checks are only an atomic load every few thousand items.
+static void BM_FilterRun(benchmark::State &state)
+{
+    KeybindStore store;
+    store.append(keybinds(int(state.range(0))));
+    auto indexes = std::make_shared<KeybindFilter::Indexes>();
+    indexes->build(store);
+
+    KeybindFilter::Request request;
+    request.itemCount = store.size();
+    request.text = Query.left(4);
+    request.fuzzy = true;
+
+    std::atomic<quint64> latest(1);
+    const CancelToken cancel = state.range(1) ? CancelToken(&latest, 1) : CancelToken();
+
+    KeybindFilter filter;
+    KeybindFilter::Result result;
+    for (auto _ : state) {
+        // Start from every item rather than narrowing the last result
+        filter.reset();
+        benchmark::DoNotOptimize(filter.run(indexes, request, cancel, &result));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FilterRun)
+    ->ArgsProduct({ { 1000, 100000, 1000000 }, { 0, 1 } })
+    ->ArgNames({ "items", "cancellable" })
+    ->Unit(benchmark::kMicrosecond);
+
+// Press-to-find over the built-in sample binds: parse each keybind back to a
+// chord and look it up. Fails if a keyboard bind of the sample data does not
+// parse, so every key spelling it uses (letters, digits, named keys,
+// punctuation such as "=") stays findable. Mouse binds have no key to press.
+static void BM_ChordLookup(benchmark::State &state)
+{
+    static const QStringList MouseKeys = { "LMB", "RMB", "Mouse Wheel Up", "Mouse Wheel Down" };
+
+    KeybindStore store;
+    const QList<KeybindItem> items = KeybindParser::sampleData();
+    store.append(items);
+    ChordIndex index;
+    index.build(store);
+
+    std::vector<KeyChord> chords;
+    for (const KeybindItem &item : items) {
+        if (MouseKeys.contains(item.keybind.section(QLatin1String(" + "), -1))) {
+            continue;
+        }
+        const KeyChord chord = KeyChord::fromKeybind(item.keybind);
+        if (!chord.isValid() || index.find(chord).empty()) {
+            state.SkipWithError(qPrintable("Sample keybind has no chord: " + item.keybind));
+            return;
+        }
+        chords.push_back(chord);
+    }
+
+    for (auto _ : state) {
+        for (const KeyChord &chord : chords) {
+            benchmark::DoNotOptimize(index.find(chord));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * qint64(chords.size()));
+}
+BENCHMARK(BM_ChordLookup);
+
+// data() for every role of every visible row, with an active filter
+static void BM_ModelData(benchmark::State &state)
+{
+    KeybindModel model;
+    model.setItemsPerPage(50);
+    model.setKeybinds(keybinds(10000));
+    model.setFilterText(Query.left(4));
+    model.refresh();
+
+    const int role = int(state.range(0));
+    const int rows = model.rowCount();
+    for (auto _ : state) {
+        for (int row = 0; row < rows; ++row) {
+            benchmark::DoNotOptimize(model.data(model.index(row), role));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetLabel(model.roleNames().value(role).toStdString());
+}
+BENCHMARK(BM_ModelData)->DenseRange(KeybindModel::NameRole, KeybindModel::DispatcherRole);
+
+// Re-sorting every keybind by one role; args are keybind count and role
+static void BM_Sort(benchmark::State &state)
+{
+    KeybindModel model;
+    model.setKeybinds(keybinds(int(state.range(0))));
+    model.refresh();
+
+    const int role = int(state.range(1));
+    Qt::SortOrder order = Qt::AscendingOrder;
+    for (auto _ : state) {
+        order = order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder;
+        model.setSortRole(role);
+        model.setSortOrder(order);
+        model.refresh();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(model.roleNames().value(role).toStdString());
+}
+BENCHMARK(BM_Sort)
+    ->ArgsProduct({ { 1000, 100000 }, { KeybindModel::KeybindRole, KeybindModel::NameRole, KeybindModel::DispatcherRole } })
+    ->ArgNames({ "items", "role" })
+    ->Unit(benchmark::kMillisecond);
+
+// One fetchMore() in continuous-scroll mode after the given number of rows
+// are materialized; should not grow with the offset
+static void BM_FetchMore(benchmark::State &state)
+{
+    KeybindModel model;
+    model.setContinuousScroll(true);
+    model.setKeybinds(keybinds(100000));
+    model.refresh();
+
+    const int offset = int(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        model.refresh();
+        while (model.rowCount() < offset && model.canFetchMore(QModelIndex())) {
+            model.fetchMore(QModelIndex());
+        }
+        state.ResumeTiming();
+        model.fetchMore(QModelIndex());
+    }
+    state.SetItemsProcessed(state.iterations() * KeybindModel::FetchChunk);
+}
+BENCHMARK(BM_FetchMore)->RangeMultiplier(10)->Range(100, 50000)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fredon-modal-cheat-bench");
+
+    // The parser logs every line it reads
+    QLoggingCategory::setFilterRules(QStringLiteral("default.debug=false"));
+
+    QTemporaryDir scratch;
+    s_scratch = &scratch;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    s_servers.clear();
+    return 0;
+}
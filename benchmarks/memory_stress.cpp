@@ -0,0 +1,67 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <cstdio>
+#include "ConfigGenerator.h"
+#include "KeybindLoader.h"
+#include "KeybindModel.h"
+#include "MemoryStats.h"
+
+// Load a synthetic config through the real loader and model, then print
+// where the memory went and the peak RSS of the whole run:
+//   memory_stress [bind count]     (default 1,000,000)
+// The keybind cache goes to a scratch directory, so every run parses.
+int main(int argc, char *argv[])
+{
+    QTemporaryDir scratch;
+    qputenv("XDG_CACHE_HOME", QFile::encodeName(scratch.path()));
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fredon-modal-cheat-stress");
+    QLoggingCategory::setFilterRules(QStringLiteral("default.debug=false"));
+
+    const int bindCount = argc > 1 ? QByteArray(argv[1]).toInt() : 1000000;
+    const QString configPath = scratch.filePath("bindings.conf");
+    if (!ConfigGenerator::writeFile(configPath, bindCount)) {
+        std::fprintf(stderr, "Could not write %s\n", qPrintable(configPath));
+        return 1;
+    }
+
+    const MemoryStats::Process baseline = MemoryStats::readProcess();
+    QElapsedTimer timer;
+    timer.start();
+
+    // Same path as a cold start: parse, stream batches, build the indexes
+    KeybindLoader loader;
+    loader.setConfigPath(configPath);
+    loader.setIpcSocketPath(QString());
+    QList<KeybindItem> items;
+    QObject::connect(&loader, &KeybindLoader::batchReady, [&items](quint64, const QList<KeybindItem> &batch) {
+        items.append(batch);
+    });
+    KeybindFilter::IndexesPtr indexes;
+    QObject::connect(&loader, &KeybindLoader::finished,
+                     [&indexes](quint64, bool, const QStringList &, const KeybindFilter::IndexesPtr &built) {
+        indexes = built;
+    });
+    loader.load(0);
+
+    const int keybindCount = int(items.size());
+    KeybindModel model;
+    model.setKeybinds(items, indexes);
+    items = QList<KeybindItem>();
+
+    // One search, so the filtered indices are populated too
+    model.setFilterText(QStringLiteral("work"));
+    model.refresh();
+
+    MemoryStats stats;
+    stats.setModel(&model);
+    std::printf("%d keybinds loaded, %d matching \"work\", in %lld ms\n",
+                keybindCount, model.filteredCount(), static_cast<long long>(timer.elapsed()));
+    std::printf("%-18s%12s\n", "RSS before loading", qPrintable(MemoryStats::formatBytes(baseline.rss)));
+    std::fputs(qPrintable(stats.report()), stdout);
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSettings>
+#include <QTemporaryDir>
+#include "ThemeManager.h"
+
+namespace {
+
+// What the ThemeManager constructor did before: read and SHA-256 the theme,
+// compare against QSettings (writing and syncing on a mismatch), then read
+// and parse the same file a second time.
+void legacyThemeStartup(const QString &themePath)
+{
+    QFile hashFile(themePath);
+    hashFile.open(QIODevice::ReadOnly);
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(hashFile.readAll());
+    const QString currentHash = QString(hash.result().toHex());
+
+    QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+    const QString storedHash = settings.value("theme/hash").toString();
+    if (storedHash != currentHash) {
+        settings.setValue("theme/hash", currentHash);
+        settings.sync();
+    }
+
+    QFile themeFile(themePath);
+    themeFile.open(QIODevice::ReadOnly);
+    const QJsonObject theme = QJsonDocument::fromJson(themeFile.readAll()).object();
+    benchmark::DoNotOptimize(QColor(theme.value("primaryColor").toString()));
+}
+
+const QString ThemePath = QStringLiteral("themes/themes.json");
+
+} // namespace
+
+static void BM_ThemeStartupLegacy(benchmark::State &state)
+{
+    for (auto _ : state) {
+        legacyThemeStartup(ThemePath);
+    }
+}
+BENCHMARK(BM_ThemeStartupLegacy);
+
+static void BM_ThemeManagerConstruct(benchmark::State &state)
+{
+    for (auto _ : state) {
+        ThemeManager manager;
+        benchmark::DoNotOptimize(manager.primaryColor());
+    }
+}
+BENCHMARK(BM_ThemeManagerConstruct);
+
+static void BM_ThemeChangeCheckLegacy(benchmark::State &state)
+{
+    // Polling used to re-hash the whole file and hit QSettings every time
+    for (auto _ : state) {
+        QFile file(ThemePath);
+        file.open(QIODevice::ReadOnly);
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        hash.addData(file.readAll());
+        QSettings settings(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+        benchmark::DoNotOptimize(settings.value("theme/hash").toString() == QString(hash.result().toHex()));
+    }
+}
+BENCHMARK(BM_ThemeChangeCheckLegacy);
+
+static void BM_ThemeChangeCheck(benchmark::State &state)
+{
+    ThemeManager manager;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.checkForThemeChanges());
+    }
+}
+BENCHMARK(BM_ThemeChangeCheck);
+
+static void BM_LoadThemeFromFile(benchmark::State &state)
+{
+    ThemeManager manager;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.loadThemeFromFile(ThemePath));
+    }
+}
+BENCHMARK(BM_LoadThemeFromFile);
+
+static void BM_ThemeSwitch(benchmark::State &state)
+{
+    // Alternate between two installed themes; only the first switch touches disk
+    ThemeManager manager;
+    bool dark = false;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.loadTheme(dark ? "dark" : "light"));
+        dark = !dark;
+    }
+}
+BENCHMARK(BM_ThemeSwitch);
+
+int main(int argc, char *argv[])
+{
+    // Keep QSettings and the theme lookup inside a scratch directory
+    QTemporaryDir scratch;
+    qputenv("XDG_CONFIG_HOME", QFile::encodeName(scratch.filePath("config")));
+    QDir().mkpath(scratch.filePath("themes"));
+    const QDir themesDir(QStringLiteral(THEMES_DIR));
+    for (const QString &fileName : themesDir.entryList(QStringList() << "*.json", QDir::Files)) {
+        QFile::copy(themesDir.filePath(fileName), scratch.filePath("themes/" + fileName));
+    }
+    QDir::setCurrent(scratch.path());
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fredon-modal-cheat-bench");
+    QCoreApplication::setOrganizationName("fredon");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
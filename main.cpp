@@ -1,70 +1,247 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 #include <QDir>
 #include <QStandardPaths>
 #include <QFile>
+#include <QFileInfo>
 #include <QDebug>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include "KeybindModel.h"
+#include "KeyIconProvider.h"
+#include "MemoryStats.h"
 #include "ThemeManager.h"
+#include "DaemonServer.h"
+#include "ReloadService.h"
+#include "QueryCli.h"
+#include "StartupTrace.h"
+
+// Value following an option such as "--qml <path>", or empty
+static QString argumentValue(int argc, char *argv[], const char *name)
+{
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0)
+            return QString::fromLocal8Bit(argv[i + 1]);
+    }
+    return QString();
+}
+
+// Check whether a plain command line flag was passed
+static bool hasArgument(int argc, char *argv[], const char *name)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Run done once the first frame is on screen and the keybinds have loaded.
+// A daemon starts hidden and may not show a frame for hours, so for a
+// hidden window only the load is waited for.
+static void whenReady(QObject *rootObject, KeybindModel *keybindModel, const std::function<void()> &done)
+{
+    auto pendingPhases = std::make_shared<int>(2);
+    auto phaseDone = [pendingPhases, done]() {
+        if (--*pendingPhases == 0) {
+            done();
+        }
+    };
+    QQuickWindow *window = qobject_cast<QQuickWindow *>(rootObject);
+    if (window && window->isVisible()) {
+        QObject::connect(window, &QQuickWindow::frameSwapped, keybindModel, phaseDone,
+                         Qt::ConnectionType(Qt::QueuedConnection | Qt::SingleShotConnection));
+    } else {
+        phaseDone();
+    }
+    QObject::connect(keybindModel, &KeybindModel::loaded, keybindModel, phaseDone,
+                     Qt::ConnectionType(Qt::QueuedConnection | Qt::SingleShotConnection));
+}
 
 int main(int argc, char *argv[])
 {
+    StartupTrace::start();
+
+    // Client mode: forward the command to a running daemon and exit
+    QByteArray clientCommand;
+    if (hasArgument(argc, argv, "--toggle")) {
+        clientCommand = "toggle";
+    } else if (hasArgument(argc, argv, "--show")) {
+        clientCommand = "show";
+    } else if (hasArgument(argc, argv, "--hide")) {
+        clientCommand = "hide";
+    }
+
+    if (!clientCommand.isEmpty()) {
+        QCoreApplication client(argc, argv);
+        if (!DaemonServer::sendCommand(clientCommand)) {
+            qWarning() << "No daemon running at" << DaemonServer::socketPath();
+            return 1;
+        }
+        return 0;
+    }
+
+    // Headless listing for other tools; never touches the GUI stack
+    if (hasArgument(argc, argv, "--list")) {
+        return QueryCli::run(argc, argv);
+    }
+
+    const bool daemonMode = hasArgument(argc, argv, "--daemon");
+
+    // --trace-startup [file] writes a Chrome trace of the launch phases
+    if (hasArgument(argc, argv, "--trace-startup")) {
+        QString tracePath = argumentValue(argc, argv, "--trace-startup");
+        if (tracePath.isEmpty() || tracePath.startsWith('-')) {
+            tracePath = "startup-trace.json";
+        }
+        StartupTrace::enable(tracePath);
+    }
+
     // Enable high DPI scaling
+    const qint64 appStart = StartupTrace::now();
     QGuiApplication app(argc, argv);
+    StartupTrace::complete("QGuiApplication", appStart);
     
     // Set the application name and organization
     QGuiApplication::setApplicationName("fredon-modal-cheat");
     QGuiApplication::setOrganizationName("fredon");
     
     qDebug() << "Starting fredon-modal-cheat application";
-    
-    // Register the KeybindModel type for use in QML
-    qmlRegisterType<KeybindModel>("KeybindModel", 1, 0, "KeybindModel");
+
+    // In daemon mode the window is hidden instead of closed, so keep running
+    DaemonServer daemonServer;
+    if (daemonMode) {
+        if (!daemonServer.listen()) {
+            return 1;
+        }
+        app.setQuitOnLastWindowClosed(false);
+    }
     
     // Create the QML engine
     QQmlApplicationEngine engine;
+    engine.rootContext()->setContextProperty("daemonMode", daemonMode);
     
     // Create and expose the keybind model to QML
     KeybindModel *keybindModel = new KeybindModel(&engine);
+    const QString configPath = argumentValue(argc, argv, "--config");
+    if (!configPath.isEmpty()) {
+        keybindModel->setConfigPath(QFileInfo(configPath).absoluteFilePath());
+    }
+    // One lazily growing list instead of fixed pages
+    if (hasArgument(argc, argv, "--continuous")) {
+        keybindModel->setContinuousScroll(true);
+    }
+    if (hasArgument(argc, argv, "--no-ipc")) {
+        keybindModel->setIpcSocketPath(QString());
+    } else if (hasArgument(argc, argv, "--ipc-socket")) {
+        keybindModel->setIpcSocketPath(argumentValue(argc, argv, "--ipc-socket"));
+    }
     engine.rootContext()->setContextProperty("keybindModel", keybindModel);
     
     // Create and expose the theme manager to QML
-    ThemeManager *themeManager = new ThemeManager(&engine);
+    ThemeManager *themeManager = nullptr;
+    {
+        StartupTrace::Scope trace("ThemeManager");
+        themeManager = new ThemeManager(&engine);
+    }
     engine.rootContext()->setContextProperty("themeManager", themeManager);
-    
-    // List available themes
-    QStringList themes = themeManager->availableThemes();
-    qDebug() << "Available themes:" << themes;
-    
-    // Determine QML file path
-    QString appDir = QCoreApplication::applicationDirPath();
-    QString qmlPath = appDir + "/test.qml";
-    
-    // If test.qml doesn't exist, try main.qml
-    if (!QFile::exists(qmlPath)) {
-        qmlPath = appDir + "/main.qml";
-        if (!QFile::exists(qmlPath)) {
-            qmlPath = "main.qml";
-        }
+
+    // Keybind icons are decoded asynchronously; the engine owns the provider
+    KeyIconProvider *iconProvider = new KeyIconProvider;
+    engine.addImageProvider("keyicon", iconProvider);
+
+    // Memory accounting for --memstats and, in debug builds, the F12 overlay
+    MemoryStats *memoryStats = new MemoryStats(&engine);
+    memoryStats->setModel(keybindModel);
+    memoryStats->addCounter("icon cache", [iconProvider]() {
+        return iconProvider->cacheBytes();
+    });
+    memoryStats->addCounter("theme", [themeManager]() {
+        return themeManager->memoryUsage();
+    });
+    engine.rootContext()->setContextProperty("memoryStats", memoryStats);
+#ifdef QT_NO_DEBUG
+    engine.rootContext()->setContextProperty("memoryOverlayAvailable", false);
+#else
+    engine.rootContext()->setContextProperty("memoryOverlayAvailable", true);
+#endif
+    
+    // The UI is compiled into the binary; --qml loads an on-disk file instead while developing
+    QUrl qmlUrl(QStringLiteral("qrc:/qt/qml/HyprKeys/main.qml"));
+    const QString qmlOverride = argumentValue(argc, argv, "--qml");
+    if (!qmlOverride.isEmpty()) {
+        qmlUrl = QUrl::fromLocalFile(QFileInfo(qmlOverride).absoluteFilePath());
     }
     
-    qDebug() << "Loading QML file:" << qmlPath;
+    qDebug() << "Loading QML file:" << qmlUrl;
     
     // Load the QML file
-    engine.load(QUrl::fromLocalFile(qmlPath));
+    {
+        StartupTrace::Scope trace("engine.load");
+        engine.load(qmlUrl);
+    }
     
     if (engine.rootObjects().isEmpty()) {
-        qDebug() << "Failed to load QML file:" << qmlPath;
+        qDebug() << "Failed to load QML file:" << qmlUrl;
         return -1;
     }
     
     qDebug() << "QML file loaded successfully";
-    
-    // Load the keybinds
+
+    // Route daemon commands to the window's show/hide animations
+    QObject *rootObject = engine.rootObjects().first();
+    QObject::connect(&daemonServer, &DaemonServer::showRequested, rootObject, [rootObject]() {
+        QMetaObject::invokeMethod(rootObject, "popup");
+    });
+    QObject::connect(&daemonServer, &DaemonServer::hideRequested, rootObject, [rootObject]() {
+        QMetaObject::invokeMethod(rootObject, "dismiss");
+    });
+    QObject::connect(&daemonServer, &DaemonServer::toggleRequested, rootObject, [rootObject]() {
+        QMetaObject::invokeMethod(rootObject, "toggle");
+    });
+    
+    // Report time to first frame, then persist the theme fingerprint off the startup path
+    if (QQuickWindow *window = qobject_cast<QQuickWindow *>(rootObject)) {
+        QObject::connect(window, &QQuickWindow::frameSwapped, window, []() {
+            StartupTrace::instant("frameSwapped");
+            qDebug() << "First frame after" << StartupTrace::now() / 1000000 << "ms";
+        }, Qt::ConnectionType(Qt::DirectConnection | Qt::SingleShotConnection));
+        QObject::connect(window, &QQuickWindow::frameSwapped, themeManager, &ThemeManager::persistThemeState,
+                         Qt::ConnectionType(Qt::QueuedConnection | Qt::SingleShotConnection));
+    }
+
+    // Reload keybinds and theme when their files change on disk
+    ReloadService reloadService;
+    QObject::connect(keybindModel, &KeybindModel::sourceFilesChanged, &reloadService, &ReloadService::setKeybindFiles);
+    QObject::connect(&reloadService, &ReloadService::keybindFilesChanged, keybindModel, &KeybindModel::reloadKeybinds);
+    QObject::connect(&reloadService, &ReloadService::themeFileChanged, themeManager, &ThemeManager::reloadTheme);
+    QObject::connect(themeManager, &ThemeManager::themeChanged, &reloadService, [&reloadService, themeManager]() {
+        reloadService.setThemeFile(themeManager->currentThemePath());
+    });
+    reloadService.setThemeFile(themeManager->currentThemePath());
+
+    // The trace is complete once the first frame is up and the keybinds are in
+    if (StartupTrace::isEnabled()) {
+        whenReady(rootObject, keybindModel, []() {
+            StartupTrace::finish();
+        });
+    }
+
+    // --memstats prints the memory report at the same point
+    if (hasArgument(argc, argv, "--memstats")) {
+        whenReady(rootObject, keybindModel, [memoryStats]() {
+            std::fputs(qPrintable(memoryStats->report()), stdout);
+            std::fflush(stdout);
+        });
+    }
+
+    // Load the keybinds on the loader thread; rows stream in as they are parsed
     qDebug() << "Loading keybinds...";
     keybindModel->loadKeybinds();
-    qDebug() << "Keybinds loaded";
     
     qDebug() << "Starting application event loop...";
     int result = app.exec();
@@ -2,11 +2,12 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Window 2.15
-import KeybindModel 1.0
+import HyprKeys 1.0
 
 ApplicationWindow {
     id: mainWindow
-    visible: true
+    // A resident daemon starts hidden and waits for a show/toggle command
+    visible: !daemonMode
     width: 900
     height: 400
     flags: Qt.FramelessWindowHint | Qt.WindowStaysOnTopHint | Qt.Tool
@@ -18,6 +19,9 @@ ApplicationWindow {
     // Position at bottom center of screen (final position)
     x: (Screen.width - width) / 2
 
+    // Debug builds: F12 toggles the memory overlay
+    property bool memoryOverlayVisible: false
+
     // Animation for liquid popup effect
     NumberAnimation {
         id: showAnimation
@@ -37,6 +41,42 @@ ApplicationWindow {
         to: Screen.height
         duration: 200
         easing.type: Easing.InCubic
+
+        // Keep the window alive in daemon mode, otherwise exit
+        onFinished: {
+            if (daemonMode) {
+                mainWindow.visible = false;
+            } else {
+                Qt.quit();
+            }
+        }
+    }
+
+    // Slide the window in (called by the daemon on show/toggle)
+    function popup() {
+        hideAnimation.stop();
+        mainWindow.y = Screen.height;
+        mainWindow.visible = true;
+        mainWindow.raise();
+        mainWindow.requestActivate();
+        showAnimation.start();
+    }
+
+    // Slide the window out; it is hidden or the app quits when done
+    function dismiss() {
+        if (!mainWindow.visible || hideAnimation.running) {
+            return;
+        }
+        showAnimation.stop();
+        hideAnimation.start();
+    }
+
+    function toggle() {
+        if (mainWindow.visible && !hideAnimation.running) {
+            dismiss();
+        } else {
+            popup();
+        }
     }
 
     // Main container with rounded top corners
@@ -80,6 +120,36 @@ ApplicationWindow {
                 Item {
                     Layout.fillWidth: true
                 }
+
+                Text {
+                    text: keybindModel.chordConflicts + (keybindModel.chordConflicts === 1 ? " conflict" : " conflicts")
+                    visible: keybindModel.chordConflicts > 0
+                    font.pixelSize: 14
+                    color: themeManager.errorColor
+                    Layout.alignment: Qt.AlignRight
+
+                    ToolTip.visible: conflictHover.hovered
+                    ToolTip.text: keybindModel.chordConflicts > 0 ? keybindModel.conflictDescriptions().join("\n") : ""
+                    HoverHandler {
+                        id: conflictHover
+                    }
+                }
+
+                Text {
+                    text: "Loading…"
+                    visible: keybindModel.loading
+                    font.pixelSize: 14
+                    color: Qt.darker(themeManager.textColor, 1.5)
+                    Layout.alignment: Qt.AlignRight
+                }
+
+                Text {
+                    text: "Searching…"
+                    visible: keybindModel.filtering && !keybindModel.loading
+                    font.pixelSize: 14
+                    color: Qt.darker(themeManager.textColor, 1.5)
+                    Layout.alignment: Qt.AlignRight
+                }
                 
                 // Close button
                 Rectangle {
@@ -99,7 +169,7 @@ ApplicationWindow {
                     MouseArea {
                         anchors.fill: parent
                         onClicked: {
-                            Qt.quit();
+                            mainWindow.dismiss();
                         }
                     }
                 }
@@ -113,24 +183,89 @@ ApplicationWindow {
             color: themeManager.surfaceColor
             radius: 8
             
-            TextField {
+            RowLayout {
                 anchors.fill: parent
                 anchors.margins: 8
-                placeholderText: "Search keybinds..."
-                color: themeManager.textColor
-                placeholderTextColor: Qt.darker(themeManager.textColor, 1.5)
-                font.pixelSize: 14
-                background: Rectangle {
-                    color: "transparent"
+                spacing: 8
+
+                TextField {
+                    id: searchField
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+                    visible: !chordCapture.activeFocus
+                    placeholderText: keybindModel.chordFilter !== ""
+                                     ? "Showing " + keybindModel.chordFilter + " (type to search)"
+                                     : "Search keybinds..."
+                    color: themeManager.textColor
+                    placeholderTextColor: Qt.darker(themeManager.textColor, 1.5)
+                    font.pixelSize: 14
+                    background: Rectangle {
+                        color: "transparent"
+                    }
+                    
+                    onTextChanged: {
+                        keybindModel.filterText = text;
+                    }
+                    
+                    Keys.onEscapePressed: {
+                        text = "";
+                        keybindModel.filterText = "";
+                        keybindModel.clearChordFilter();
+                    }
                 }
-                
-                onTextChanged: {
-                    keybindModel.filterText = text;
+
+                // Press-to-find: the next key combination selects the rows bound to it
+                Item {
+                    id: chordCapture
+                    Layout.fillWidth: activeFocus
+                    Layout.fillHeight: true
+                    visible: activeFocus
+
+                    Text {
+                        anchors.verticalCenter: parent.verticalCenter
+                        text: "Press a key combination… (Esc to cancel)"
+                        color: themeManager.accentColor
+                        font.pixelSize: 14
+                    }
+
+                    Keys.onPressed: function(event) {
+                        event.accepted = true;
+                        switch (event.key) {
+                        case Qt.Key_Shift:
+                        case Qt.Key_Control:
+                        case Qt.Key_Alt:
+                        case Qt.Key_Meta:
+                        case Qt.Key_Super_L:
+                        case Qt.Key_Super_R:
+                        case Qt.Key_AltGr:
+                            // Wait for the key that completes the chord
+                            return;
+                        case Qt.Key_Escape:
+                            searchField.forceActiveFocus();
+                            return;
+                        }
+                        searchField.text = "";
+                        keybindModel.findChord(event.key, event.modifiers, event.nativeScanCode);
+                        searchField.forceActiveFocus();
+                    }
                 }
-                
-                Keys.onEscapePressed: {
-                    text = "";
-                    keybindModel.filterText = "";
+
+                Button {
+                    Layout.preferredWidth: 32
+                    Layout.fillHeight: true
+                    onClicked: chordCapture.forceActiveFocus()
+                    background: Rectangle {
+                        color: chordCapture.activeFocus || keybindModel.chordFilter !== ""
+                               ? themeManager.primaryColor : "transparent"
+                        radius: 6
+                    }
+                    contentItem: Text {
+                        text: "⌨"
+                        color: themeManager.textColor
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                        font.pixelSize: 14
+                    }
                 }
             }
         }
@@ -166,6 +301,43 @@ ApplicationWindow {
                     font.bold: true
                     color: themeManager.textColor
                 }
+
+                // Sort mode; the model keeps the filter and moves rows into the new order
+                ComboBox {
+                    id: sortBox
+                    Layout.preferredWidth: 140
+                    Layout.preferredHeight: 28
+                    textRole: "text"
+                    valueRole: "role"
+                    model: [
+                        { text: "File order", role: 0 },
+                        { text: "Keybind", role: KeybindModel.KeybindRole },
+                        { text: "Name", role: KeybindModel.NameRole },
+                        { text: "Dispatcher", role: KeybindModel.DispatcherRole },
+                        { text: "Description", role: KeybindModel.DescriptionRole }
+                    ]
+                    Component.onCompleted: currentIndex = indexOfValue(keybindModel.sortRole)
+                    onActivated: keybindModel.sortRole = currentValue
+                }
+
+                Button {
+                    Layout.preferredWidth: 28
+                    Layout.preferredHeight: 28
+                    enabled: keybindModel.sortRole !== 0
+                    onClicked: keybindModel.sortOrder = keybindModel.sortOrder === Qt.AscendingOrder
+                                                        ? Qt.DescendingOrder : Qt.AscendingOrder
+                    background: Rectangle {
+                        color: enabled ? themeManager.secondaryColor : "transparent"
+                        radius: 6
+                    }
+                    contentItem: Text {
+                        text: keybindModel.sortOrder === Qt.AscendingOrder ? "▲" : "▼"
+                        color: enabled ? themeManager.backgroundColor : Qt.darker(themeManager.textColor, 1.5)
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                        font.pixelSize: 12
+                    }
+                }
             }
         }
 
@@ -185,90 +357,48 @@ ApplicationWindow {
                 clip: true
                 spacing: 5
                 boundsBehavior: Flickable.StopAtBounds
+                // Rows are inserted, removed and moved instead of reset, so keep delegates around
+                reuseItems: true
+
+                // In continuous-scroll mode the model grows through fetchMore() as
+                // this nears the end, and the page indicator follows the top row
+                onContentYChanged: {
+                    if (keybindModel.continuousScroll) {
+                        var row = indexAt(0, contentY)
+                        if (row >= 0) {
+                            keybindModel.currentPage = Math.floor(row / keybindModel.itemsPerPage)
+                        }
+                    }
+                }
+
+                // Show the given page, or scroll to its section
+                function goToPage(page) {
+                    var row = keybindModel.jumpToSection(page)
+                    if (keybindModel.continuousScroll) {
+                        positionViewAtIndex(row, ListView.Beginning)
+                    }
+                }
 
-                delegate: Rectangle {
+                // One painted item per row; see KeybindRowItem
+                delegate: KeybindRowItem {
                     width: ListView.view.width
                     height: 50
                     color: index % 2 === 0 ? Qt.darker(themeManager.surfaceColor, 1.2) : themeManager.surfaceColor
                     radius: 6
-
-                    RowLayout {
-                        anchors.fill: parent
-                        anchors.margins: 10
-
-                        // Keybind with icon
-                        Rectangle {
-                            Layout.preferredWidth: 150
-                            Layout.fillHeight: true
-                            color: "transparent"
-
-                            Row {
-                                anchors.centerIn: parent
-                                spacing: 8
-
-                                Image {
-                                    source: model.icon && model.icon !== "" ? model.icon : ""
-                                    width: 20
-                                    height: 20
-                                    fillMode: Image.PreserveAspectFit
-                                    
-                                    // Only show placeholder if icon is empty or doesn't exist
-                                    visible: model.icon && model.icon !== ""
-                                    
-                                    // Handle loading errors
-                                    onStatusChanged: {
-                                        if (status === Image.Error) {
-                                            visible = false;
-                                        }
-                                    }
-                                }
-
-                                // Placeholder icon when no icon is available
-                                Rectangle {
-                                    width: 20
-                                    height: 20
-                                    color: "transparent"
-                                    visible: !model.icon || model.icon === ""
-                                    
-                                    Text {
-                                        anchors.centerIn: parent
-                                        text: "🔍"
-                                        color: themeManager.accentColor
-                                        font.pixelSize: 14
-                                    }
-                                }
-
-                                Text {
-                                    text: model.keybind
-                                    font.bold: true
-                                    font.pixelSize: 14
-                                    color: themeManager.accentColor
-                                    Layout.alignment: Qt.AlignVCenter
-                                }
-                            }
-                        }
-
-                        // Command name
-                        Text {
-                            Layout.preferredWidth: 200
-                            text: model.name
-                            font.pixelSize: 14
-                            color: themeManager.secondaryColor
-                            elide: Text.ElideRight
-                            Layout.alignment: Qt.AlignVCenter
-                        }
-
-                        // Description
-                        Text {
-                            Layout.fillWidth: true
-                            text: model.description
-                            font.pixelSize: 14
-                            color: themeManager.textColor
-                            wrapMode: Text.WordWrap
-                            Layout.alignment: Qt.AlignVCenter
-                            elide: Text.ElideRight
-                        }
-                    }
+                    primaryColor: themeManager.primaryColor
+                    secondaryColor: themeManager.secondaryColor
+                    accentColor: themeManager.accentColor
+                    textColor: themeManager.textColor
+
+                    keybind: model.keybind
+                    name: model.name
+                    description: model.description
+                    icon: model.icon || ""
+                    matchRanges: model.matchRanges
+
+                    // Live delegates, pooled ones included, for --memstats
+                    Component.onCompleted: memoryStats.delegateCreated()
+                    Component.onDestruction: memoryStats.delegateDestroyed()
                 }
 
                 // Scroll bar styling
@@ -299,7 +429,7 @@ ApplicationWindow {
                     enabled: keybindModel.currentPage > 0
                     onClicked: {
                         if (keybindModel.currentPage > 0) {
-                            keybindModel.currentPage--;
+                            keybindListView.goToPage(keybindModel.currentPage - 1);
                         }
                     }
                     background: Rectangle {
@@ -327,7 +457,7 @@ ApplicationWindow {
                     enabled: keybindModel.currentPage < keybindModel.totalPages - 1
                     onClicked: {
                         if (keybindModel.currentPage < keybindModel.totalPages - 1) {
-                            keybindModel.currentPage++;
+                            keybindListView.goToPage(keybindModel.currentPage + 1);
                         }
                     }
                     background: Rectangle {
@@ -349,15 +479,52 @@ ApplicationWindow {
     // Initialize on component completion
     Component.onCompleted: {
         // Small delay to ensure window is ready before animation
-        showAnimation.start();
+        if (!daemonMode) {
+            showAnimation.start();
+        }
     }
 
     // Close on Escape key
     Keys.onEscapePressed: {
-        hideAnimation.start();
-        hideAnimation.finished.connect(function() {
-            Qt.quit();
-        });
+        dismiss();
+    }
+
+    Shortcut {
+        sequence: "F12"
+        enabled: memoryOverlayAvailable
+        onActivated: mainWindow.memoryOverlayVisible = !mainWindow.memoryOverlayVisible
+    }
+
+    // Memory report, refreshed every second; only available in debug builds
+    Loader {
+        active: memoryOverlayAvailable && mainWindow.memoryOverlayVisible
+        anchors.right: parent.right
+        anchors.bottom: parent.bottom
+        anchors.margins: 16
+        z: 100
+
+        sourceComponent: Rectangle {
+            width: memoryText.implicitWidth + 16
+            height: memoryText.implicitHeight + 16
+            radius: 6
+            color: Qt.rgba(0, 0, 0, 0.8)
+
+            Text {
+                id: memoryText
+                anchors.centerIn: parent
+                font.family: "monospace"
+                font.pixelSize: 11
+                color: "white"
+                text: memoryStats.report()
+            }
+
+            Timer {
+                interval: 1000
+                running: true
+                repeat: true
+                onTriggered: memoryText.text = memoryStats.report()
+            }
+        }
     }
 
     // Make window draggable from header area
@@ -0,0 +1,152 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QtTest>
+#include "FakeHyprlandServer.h"
+#include "HyprlandIpcSource.h"
+
+namespace {
+
+// One j/binds entry with the fields Hyprland sends
+QJsonObject bind(int modmask, const QString &key, int keycode, const QString &dispatcher, const QString &arg,
+                 const QString &submap = QString(), bool hasDescription = false,
+                 const QString &description = QString())
+{
+    QJsonObject bind;
+    bind["locked"] = false;
+    bind["mouse"] = false;
+    bind["release"] = false;
+    bind["repeat"] = false;
+    bind["longPress"] = false;
+    bind["non_consuming"] = false;
+    bind["has_description"] = hasDescription;
+    bind["modmask"] = modmask;
+    bind["submap"] = submap;
+    bind["key"] = key;
+    bind["keycode"] = keycode;
+    bind["catch_all"] = false;
+    bind["description"] = description;
+    bind["dispatcher"] = dispatcher;
+    bind["arg"] = arg;
+    return bind;
+}
+
+QByteArray reply(const QJsonObject &entry)
+{
+    return QJsonDocument(QJsonArray { entry }).toJson(QJsonDocument::Compact);
+}
+
+} // namespace
+
+// HyprlandIpcSource against fixed j/binds replies served by the fake
+// compositor, over a real local socket
+class HyprlandIpcTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void fetch_data();
+    void fetch();
+    void fetchUnknownReply();
+    void fetchWithoutSocket();
+
+private:
+    QString socketPath(const char *name) const;
+
+    QTemporaryDir m_dir;
+    KeybindParser m_parser;
+};
+
+void HyprlandIpcTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+QString HyprlandIpcTest::socketPath(const char *name) const
+{
+    return m_dir.filePath(QString("%1.sock").arg(QLatin1String(name)));
+}
+
+void HyprlandIpcTest::fetch_data()
+{
+    QTest::addColumn<QByteArray>("reply");
+    QTest::addColumn<QString>("keybind");
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<QString>("description");
+    QTest::addColumn<QString>("dispatcher");
+
+    QTest::newRow("modmask")
+        << reply(bind(64 | 1, "W", 0, "movetoworkspace", "2"))
+        << "SUPER SHIFT + W" << "Movetoworkspace" << "movetoworkspace 2" << "movetoworkspace";
+    QTest::newRow("all modifiers in display order")
+        << reply(bind(8 | 4 | 1 | 64, "Q", 0, "killactive", ""))
+        << "SUPER SHIFT CTRL ALT + Q" << "Killactive" << "killactive" << "killactive";
+    QTest::newRow("no modifiers")
+        << reply(bind(0, "Print", 0, "pin", ""))
+        << "Print" << "Pin" << "pin" << "pin";
+    QTest::newRow("submap prefix")
+        << reply(bind(8, "l", 0, "resizeactive", "10 0", "resize"))
+        << "resize: ALT + L" << "Resizeactive" << "resizeactive 10 0" << "resizeactive";
+    QTest::newRow("bindd description")
+        << reply(bind(64, "F", 0, "fullscreen", "0", QString(), true, "Fullscreen the window"))
+        << "SUPER + F" << "Fullscreen" << "Fullscreen the window" << "fullscreen";
+    QTest::newRow("description without has_description")
+        << reply(bind(64, "F", 0, "fullscreen", "0", QString(), false, "Ignored"))
+        << "SUPER + F" << "Fullscreen" << "fullscreen 0" << "fullscreen";
+    QTest::newRow("keycode without key")
+        << reply(bind(64, QString(), 24, "togglefloating", ""))
+        << "SUPER + code:24" << "Togglefloating" << "togglefloating" << "togglefloating";
+    QTest::newRow("key wins over keycode")
+        << reply(bind(64, "V", 55, "togglefloating", ""))
+        << "SUPER + V" << "Togglefloating" << "togglefloating" << "togglefloating";
+}
+
+void HyprlandIpcTest::fetch()
+{
+    QFETCH(QByteArray, reply);
+    QFETCH(QString, keybind);
+    QFETCH(QString, name);
+    QFETCH(QString, description);
+    QFETCH(QString, dispatcher);
+
+    FakeHyprlandServer server(socketPath("binds"), reply);
+    QVERIFY(server.listen());
+
+    QList<KeybindItem> items;
+    const HyprlandIpcSource source(socketPath("binds"));
+    QVERIFY(source.fetch(m_parser, [&items](const KeybindItem &item) {
+        items.append(item);
+    }));
+
+    QCOMPARE(items.size(), 1);
+    QCOMPARE(items[0].keybind, keybind);
+    QCOMPARE(items[0].name, name);
+    QCOMPARE(items[0].description, description);
+    QCOMPARE(items[0].dispatcher, dispatcher);
+}
+
+// Anything but a JSON array is not a bind list
+void HyprlandIpcTest::fetchUnknownReply()
+{
+    FakeHyprlandServer server(socketPath("unknown"), QByteArray("unknown request"));
+    QVERIFY(server.listen());
+
+    int count = 0;
+    const HyprlandIpcSource source(socketPath("unknown"));
+    QVERIFY(!source.fetch(m_parser, [&count](const KeybindItem &) {
+        ++count;
+    }));
+    QCOMPARE(count, 0);
+}
+
+void HyprlandIpcTest::fetchWithoutSocket()
+{
+    const HyprlandIpcSource source(socketPath("missing"));
+    QVERIFY(!source.isAvailable());
+    QVERIFY(!source.fetch(m_parser, [](const KeybindItem &) {}));
+}
+
+QTEST_GUILESS_MAIN(HyprlandIpcTest)
+#include "hyprland_ipc_test.moc"